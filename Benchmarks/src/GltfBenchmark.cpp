@@ -0,0 +1,129 @@
+#include "OCASI/Core/Importer.h"
+#include "OCASI/Importers/GLTF2/JsonParser.h"
+
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+
+// Usage: OCASI-GltfBenchmark [node count]
+// Builds a .gltf file with the requested number of nodes (500000 by default, around 100 MB of JSON) and imports it
+// from memory with every simdjson kernel supported by this CPU, starting with the scalar fallback kernel. Every kernel
+// reports the fastest of three imports.
+
+namespace {
+
+    constexpr size_t NODES_PER_MESH = 100;
+    constexpr size_t MATERIAL_COUNT = 1000;
+    constexpr size_t RUN_COUNT = 3;
+
+    // A single triangle, that is shared by all meshes: three vec3 positions followed by three uint16 indices
+    std::vector<uint8_t> CreateBuffer()
+    {
+        const float positions[] = { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+        const uint16_t indices[] = { 0, 1, 2 };
+
+        std::vector<uint8_t> buffer(sizeof(positions) + sizeof(indices));
+        std::memcpy(buffer.data(), positions, sizeof(positions));
+        std::memcpy(buffer.data() + sizeof(positions), indices, sizeof(indices));
+        return buffer;
+    }
+
+    std::string CreateGltfFile(size_t nodeCount, size_t bufferSize)
+    {
+        size_t meshCount = std::max<size_t>(nodeCount / NODES_PER_MESH, 1);
+
+        std::string file;
+        file.reserve(nodeCount * 220);
+        file += R"({"asset":{"version":"2.0","generator":"OCASI-GltfBenchmark"},"scene":0,)";
+        file += FORMAT(R"("buffers":[{{"uri":"scene.bin","byteLength":{}}}],)", bufferSize);
+        file += R"("bufferViews":[{"buffer":0,"byteOffset":0,"byteLength":36},{"buffer":0,"byteOffset":36,"byteLength":6}],)";
+        file += R"("accessors":[{"bufferView":0,"componentType":5126,"count":3,"type":"VEC3","min":[0,0,0],"max":[1,1,0]},)";
+        file += R"({"bufferView":1,"componentType":5123,"count":3,"type":"SCALAR"}],)";
+
+        file += R"("materials":[)";
+        for (size_t i = 0; i < MATERIAL_COUNT; i++)
+        {
+            file += FORMAT(R"({}{{"name":"Material{}","pbrMetallicRoughness":{{"baseColorFactor":[{:.4f},0.5,0.25,1.0],"metallicFactor":{:.3f},"roughnessFactor":0.5}},"doubleSided":true}})",
+                           i ? "," : "", i, (float) i / MATERIAL_COUNT, (float) (i % 10) / 10.0f);
+        }
+        file += "],";
+
+        file += R"("meshes":[)";
+        for (size_t i = 0; i < meshCount; i++)
+            file += FORMAT(R"({}{{"name":"Mesh{}","primitives":[{{"attributes":{{"POSITION":0}},"indices":1,"material":{}}}]}})", i ? "," : "", i, i % MATERIAL_COUNT);
+        file += "],";
+
+        file += R"("nodes":[)";
+        for (size_t i = 0; i < nodeCount; i++)
+        {
+            file += FORMAT(R"({}{{"name":"Node{}","mesh":{},"translation":[{:.3f},{:.3f},-{:.3f}],"rotation":[0.0,0.7071068,0.0,0.7071068],"scale":[1.5,1.5,1.5]}})",
+                           i ? "," : "", i, i % meshCount, (float) (i % 1000) * 0.25f, (float) (i / 1000) * 0.25f, (float) i * 0.001f);
+        }
+        file += "],";
+
+        file += R"("scenes":[{"name":"Scene","nodes":[)";
+        for (size_t i = 0; i < nodeCount; i++)
+        {
+            if (i)
+                file += ',';
+            file += std::to_string(i);
+        }
+        file += "]}]}";
+        return file;
+    }
+
+    template<typename Function>
+    double Measure(Function&& function)
+    {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace OCASI;
+
+    size_t nodeCount = argc > 1 ? std::stoull(argv[1]) : 500'000;
+    std::vector<uint8_t> buffer = CreateBuffer();
+    std::string file = CreateGltfFile(nodeCount, buffer.size());
+    std::span<const uint8_t> fileData(reinterpret_cast<const uint8_t*>(file.data()), file.size());
+
+    FileResolver resolver = [&buffer](const Path& relativePath) -> std::optional<std::span<const uint8_t>>
+    {
+        if (relativePath == "scene.bin")
+            return std::span<const uint8_t>(buffer);
+        return std::nullopt;
+    };
+
+    std::string selectedKernel = GLTF::JsonParser::GetKernelName();
+    std::vector<std::string> kernels = GLTF::JsonParser::GetSupportedKernels();
+    // The fallback kernel is the baseline for the other kernels
+    std::stable_partition(kernels.begin(), kernels.end(), [](const std::string& kernel) { return kernel == "fallback"; });
+
+    OCASI_LOG_INFO(FORMAT("Importing a {} MB .gltf file with {} nodes, simdjson selected the {} kernel", file.size() / (1024 * 1024), nodeCount, selectedKernel));
+
+    double fallbackTime = 0.0;
+    for (const std::string& kernel : kernels)
+    {
+        GLTF::JsonParser::SetKernel(kernel);
+
+        double time = std::numeric_limits<double>::max();
+        for (size_t i = 0; i < RUN_COUNT; i++)
+        {
+            SharedPtr<Scene> scene = nullptr;
+            time = std::min(time, Measure([&]() { scene = Importer::Load3DFromMemory(fileData, "gltf", PostProcessorOptions::None, resolver); }));
+            if (!scene)
+                return 1;
+        }
+
+        if (kernel == "fallback")
+            fallbackTime = time;
+
+        OCASI_LOG_INFO(FORMAT("{:>10} kernel: {:.1f} ms ({:.2f}x)", kernel, time, fallbackTime > 0.0 ? fallbackTime / time : 1.0));
+    }
+
+    GLTF::JsonParser::SetKernel(selectedKernel);
+}
@@ -0,0 +1,152 @@
+#include "OCASI/Core/Importer.h"
+#include "OCASI/Importers/OBJ/VertexIndexMap.h"
+
+#include <chrono>
+#include <unordered_map>
+#include <cmath>
+
+// Usage: OCASI-ObjBenchmark [face count]
+// Builds a triangulated grid with the requested number of faces (10 million by default) and measures the vertex
+// deduplication on its own, followed by a full import of the same grid as an in-memory OBJ file.
+
+namespace {
+
+    // The face vertex key and hash, that ObjImporter::CreateMesh used before the VertexIndexMap
+    struct LegacyVertexIndices
+    {
+        size_t VertexIndex;
+        size_t TextureCoordinateIndex;
+        size_t NormalIndex;
+
+        bool operator==(const LegacyVertexIndices& other) const = default;
+    };
+
+    struct LegacyHash
+    {
+        size_t operator()(const LegacyVertexIndices& v) const
+        {
+            return std::hash<size_t>()(v.VertexIndex) + std::hash<size_t>()(v.TextureCoordinateIndex) + std::hash<size_t>()(v.NormalIndex);
+        }
+    };
+
+    struct Grid
+    {
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        // v/vt/vn triples of all face vertices. Texture coordinates are shared with the positions, every face has its own
+        // normal like a flat shaded mesh, which makes many different triples add up to the same sum.
+        std::vector<OCASI::OBJ::VertexIndices> FaceVertices;
+    };
+
+    Grid CreateGrid(size_t faceCount)
+    {
+        Grid grid;
+        uint32_t quadsPerSide = (uint32_t) std::ceil(std::sqrt((double) faceCount / 2.0));
+        grid.Width = quadsPerSide + 1;
+        grid.Height = quadsPerSide + 1;
+
+        grid.FaceVertices.reserve(faceCount * 3);
+        for (uint32_t y = 0; y < quadsPerSide && grid.FaceVertices.size() < faceCount * 3; y++)
+        {
+            for (uint32_t x = 0; x < quadsPerSide && grid.FaceVertices.size() < faceCount * 3; x++)
+            {
+                uint32_t i0 = y * grid.Width + x, i1 = i0 + 1, i2 = i0 + grid.Width, i3 = i2 + 1;
+                uint32_t face = (uint32_t) grid.FaceVertices.size() / 3;
+                for (uint32_t i : { i0, i1, i3 })
+                    grid.FaceVertices.push_back({ i, i, face });
+                for (uint32_t i : { i0, i3, i2 })
+                    grid.FaceVertices.push_back({ i, i, face + 1 });
+            }
+        }
+        grid.FaceVertices.resize(faceCount * 3);
+        return grid;
+    }
+
+    std::string CreateObjFile(const Grid& grid)
+    {
+        std::string file;
+        file.reserve(grid.FaceVertices.size() * 24);
+
+        for (uint32_t y = 0; y < grid.Height; y++)
+            for (uint32_t x = 0; x < grid.Width; x++)
+                file += FORMAT("v {} 0 {}\nvt {} {}\n", x, y, (float) x / grid.Width, (float) y / grid.Height);
+        for (size_t i = 0; i < grid.FaceVertices.size() / 3; i++)
+            file += "vn 0 1 0\n";
+
+        for (size_t i = 0; i < grid.FaceVertices.size(); i += 3)
+        {
+            file += 'f';
+            for (size_t j = i; j < i + 3; j++)
+                file += FORMAT(" {}/{}/{}", grid.FaceVertices[j].VertexIndex + 1, grid.FaceVertices[j].TextureCoordinateIndex + 1, grid.FaceVertices[j].NormalIndex + 1);
+            file += '\n';
+        }
+        return file;
+    }
+
+    template<typename Function>
+    double Measure(Function&& function)
+    {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace OCASI;
+
+    size_t faceCount = argc > 1 ? std::stoull(argv[1]) : 10'000'000;
+    Grid grid = CreateGrid(faceCount);
+    OCASI_LOG_INFO(FORMAT("Grid with {} faces and {} face vertices", faceCount, grid.FaceVertices.size()));
+
+    std::vector<uint32_t> legacyIndices, indices;
+    legacyIndices.reserve(grid.FaceVertices.size());
+    indices.reserve(grid.FaceVertices.size());
+
+    double legacyTime = Measure([&]()
+    {
+        std::unordered_map<LegacyVertexIndices, size_t, LegacyHash> lookUpTable;
+        size_t newIndex = 0;
+        for (const auto& v : grid.FaceVertices)
+        {
+            LegacyVertexIndices key = { v.VertexIndex, v.TextureCoordinateIndex, v.NormalIndex };
+            auto result = lookUpTable.try_emplace(key, newIndex);
+            legacyIndices.push_back(result.second ? (uint32_t) newIndex++ : (uint32_t) lookUpTable.at(key));
+        }
+    });
+
+    double mapTime = Measure([&]()
+    {
+        // Flat shading makes every face vertex unique
+        OBJ::VertexIndexMap lookUpTable(grid.FaceVertices.size());
+        uint32_t newIndex = 0;
+        for (const auto& v : grid.FaceVertices)
+        {
+            bool inserted = false;
+            uint32_t index = lookUpTable.TryEmplace(v, newIndex, inserted);
+            indices.push_back(index);
+            newIndex += inserted;
+        }
+    });
+
+    if (legacyIndices != indices)
+    {
+        OCASI_LOG_ERROR("The deduplicated indices do not match");
+        return 1;
+    }
+
+    OCASI_LOG_INFO(FORMAT("Deduplication with std::unordered_map: {:.1f} ms", legacyTime));
+    OCASI_LOG_INFO(FORMAT("Deduplication with OBJ::VertexIndexMap: {:.1f} ms ({:.2f}x)", mapTime, legacyTime / mapTime));
+
+    std::string file = CreateObjFile(grid);
+    std::span<const uint8_t> fileData(reinterpret_cast<const uint8_t*>(file.data()), file.size());
+
+    SharedPtr<Scene> scene = nullptr;
+    double importTime = Measure([&]() { scene = Importer::Load3DFromMemory(fileData, "obj", PostProcessorOptions::None); });
+
+    if (!scene)
+        return 1;
+
+    OCASI_LOG_INFO(FORMAT("Import of {} MB OBJ file: {:.1f} ms, {} vertices", file.size() / (1024 * 1024), importTime, scene->Models.at(0).Meshes.at(0).Vertices.size()));
+}
@@ -0,0 +1,261 @@
+#include "Base64.h"
+
+#include <array>
+#include <cstring>
+
+// The instruction set is selected at compile time like the one of the text scanner. SSE2 is part of every x86-64
+// target, AVX2 is only used if the compiler is allowed to emit it (OCASI_ENABLE_AVX2).
+#if defined(__AVX2__)
+    #define OCASI_BASE64_AVX2
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define OCASI_BASE64_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace OCASI::Util {
+
+    namespace {
+
+        constexpr size_t GROUP_SIZE = 4;
+        constexpr size_t DECODED_GROUP_SIZE = 3;
+
+        constexpr uint8_t INVALID_CHARACTER = 0x80;
+        constexpr uint8_t PADDING_CHARACTER = 0x81;
+
+        constexpr std::array<uint8_t, 256> CreateDecodingTable()
+        {
+            std::array<uint8_t, 256> table = {};
+            table.fill(INVALID_CHARACTER);
+
+            constexpr std::string_view alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            for (size_t i = 0; i < alphabet.size(); i++)
+                table[(uint8_t) alphabet[i]] = (uint8_t) i;
+            table['='] = PADDING_CHARACTER;
+            return table;
+        }
+
+        constexpr std::array<uint8_t, 256> DECODING_TABLE = CreateDecodingTable();
+
+        [[noreturn]] void ThrowInvalidCharacter(std::string_view data, size_t position)
+        {
+            throw FailedImportError(FORMAT("Could not decode Base64 string, as it contains the invalid character '{}' at position {}.", data[position], position));
+        }
+
+        // Decodes a group of 4 characters, that does not contain padding, into 3 bytes
+        void DecodeGroup(std::string_view data, size_t position, uint8_t* out)
+        {
+            uint32_t a = DECODING_TABLE[(uint8_t) data[position]];
+            uint32_t b = DECODING_TABLE[(uint8_t) data[position + 1]];
+            uint32_t c = DECODING_TABLE[(uint8_t) data[position + 2]];
+            uint32_t d = DECODING_TABLE[(uint8_t) data[position + 3]];
+
+            if ((a | b | c | d) & INVALID_CHARACTER)
+            {
+                for (size_t i = position; i < position + GROUP_SIZE; i++)
+                {
+                    if (DECODING_TABLE[(uint8_t) data[i]] & INVALID_CHARACTER)
+                        ThrowInvalidCharacter(data, i);
+                }
+            }
+
+            uint32_t group = (a << 18) | (b << 12) | (c << 6) | d;
+            out[0] = (uint8_t) (group >> 16);
+            out[1] = (uint8_t) (group >> 8);
+            out[2] = (uint8_t) group;
+        }
+
+#if defined(OCASI_BASE64_AVX2)
+
+        constexpr size_t VECTOR_WIDTH = 32;
+        // 32 characters decode to 24 bytes, but the whole register is stored
+        constexpr size_t VECTOR_OUTPUT_SIZE = 32;
+
+        // Translates the characters to their 6 bit values. Returns false, if any character is not part of the alphabet.
+        bool TranslateCharacters(__m256i characters, __m256i& outValues)
+        {
+            // Characters above 127 are negative, so they fall outside of every range
+            __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(characters, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), characters));
+            __m256i lower = _mm256_and_si256(_mm256_cmpgt_epi8(characters, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), characters));
+            __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(characters, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), characters));
+            __m256i plus = _mm256_cmpeq_epi8(characters, _mm256_set1_epi8('+'));
+            __m256i slash = _mm256_cmpeq_epi8(characters, _mm256_set1_epi8('/'));
+
+            __m256i valid = _mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(_mm256_or_si256(digit, plus), slash));
+            if (_mm256_movemask_epi8(valid) != -1)
+                return false;
+
+            __m256i shift = _mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-'A')), _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a')));
+            shift = _mm256_or_si256(shift, _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')));
+            shift = _mm256_or_si256(shift, _mm256_or_si256(_mm256_and_si256(plus, _mm256_set1_epi8(62 - '+')), _mm256_and_si256(slash, _mm256_set1_epi8(63 - '/'))));
+            outValues = _mm256_add_epi8(characters, shift);
+            return true;
+        }
+
+        bool DecodeVector(const char* data, uint8_t* out)
+        {
+            __m256i values;
+            if (!TranslateCharacters(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)), values))
+                return false;
+
+            // Merges the 6 bit values of each group into 24 bits: first pairs into 12 bits, then the pairs into 24 bits
+            __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+            __m256i groups = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+
+            // The bytes of each group are reversed and packed to the front of each 128 bit lane, then the lanes are joined
+            __m256i packed = _mm256_shuffle_epi8(groups, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                                          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+            packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), packed);
+            return true;
+        }
+
+#elif defined(OCASI_BASE64_SSE2)
+
+        constexpr size_t VECTOR_WIDTH = 16;
+        // 16 characters decode to 12 bytes, but the whole register is stored
+        constexpr size_t VECTOR_OUTPUT_SIZE = 16;
+
+        // Translates the characters to their 6 bit values. Returns false, if any character is not part of the alphabet.
+        bool TranslateCharacters(__m128i characters, __m128i& outValues)
+        {
+            // Characters above 127 are negative, so they fall outside of every range
+            __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(characters, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(characters, _mm_set1_epi8('Z' + 1)));
+            __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(characters, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(characters, _mm_set1_epi8('z' + 1)));
+            __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(characters, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(characters, _mm_set1_epi8('9' + 1)));
+            __m128i plus = _mm_cmpeq_epi8(characters, _mm_set1_epi8('+'));
+            __m128i slash = _mm_cmpeq_epi8(characters, _mm_set1_epi8('/'));
+
+            __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(_mm_or_si128(digit, plus), slash));
+            if (_mm_movemask_epi8(valid) != 0xFFFF)
+                return false;
+
+            __m128i shift = _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')), _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+            shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+            shift = _mm_or_si128(shift, _mm_or_si128(_mm_and_si128(plus, _mm_set1_epi8(62 - '+')), _mm_and_si128(slash, _mm_set1_epi8(63 - '/'))));
+            outValues = _mm_add_epi8(characters, shift);
+            return true;
+        }
+
+        bool DecodeVector(const char* data, uint8_t* out)
+        {
+            __m128i values;
+            if (!TranslateCharacters(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), values))
+                return false;
+
+            // Merges the 6 bit values of each group into 24 bits: first pairs into 12 bits, then the pairs into 24 bits
+            __m128i lowBytes = _mm_set1_epi16(0x00FF);
+            __m128i pairs = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(values, lowBytes), 6), _mm_srli_epi16(values, 8));
+            __m128i groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+
+            // SSE2 has no byte shuffle, so the 3 bytes of each group are reversed with shifts
+            __m128i lowByte = _mm_set1_epi32(0xFF);
+            __m128i reversed = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(groups, 16), lowByte), _mm_and_si128(groups, _mm_set1_epi32(0xFF00)));
+            reversed = _mm_or_si128(reversed, _mm_slli_epi32(_mm_and_si128(groups, lowByte), 16));
+
+            // Closes the gaps behind the groups: first inside each 64 bit half, then between the two halves
+            __m128i lowGroup = _mm_set1_epi64x(0xFFFFFF);
+            __m128i halves = _mm_or_si128(_mm_and_si128(reversed, lowGroup), _mm_andnot_si128(lowGroup, _mm_srli_epi64(reversed, 8)));
+            __m128i lowHalf = _mm_set_epi64x(0, -1);
+            __m128i packed = _mm_or_si128(_mm_and_si128(halves, lowHalf), _mm_srli_si128(_mm_andnot_si128(lowHalf, halves), 2));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), packed);
+            return true;
+        }
+
+#endif
+    }
+
+    const char* GetBase64InstructionSet()
+    {
+#if defined(OCASI_BASE64_AVX2)
+        return "AVX2";
+#elif defined(OCASI_BASE64_SSE2)
+        return "SSE2";
+#else
+        return "Scalar";
+#endif
+    }
+
+    size_t GetBase64DecodedSize(std::string_view data)
+    {
+        size_t size = data.size() / GROUP_SIZE * DECODED_GROUP_SIZE;
+        if (data.size() >= 1 && data[data.size() - 1] == '=')
+            size--;
+        if (data.size() >= 2 && data[data.size() - 2] == '=')
+            size--;
+        return size;
+    }
+
+    size_t DecodeBase64(std::string_view data, std::span<uint8_t> out)
+    {
+        if (data.size() % GROUP_SIZE != 0)
+            throw FailedImportError("Could not decode Base64 string, as data is not divisible by 4.");
+        if (data.empty())
+            return 0;
+
+        size_t decodedSize = GetBase64DecodedSize(data);
+        if (out.size() < decodedSize)
+            throw FailedImportError(FORMAT("Could not decode Base64 string, as the output buffer holds {} bytes instead of {} bytes.", out.size(), decodedSize));
+
+        // The last group may contain padding, so it is always decoded separately
+        size_t lastGroup = data.size() - GROUP_SIZE;
+        size_t position = 0;
+        size_t outPosition = 0;
+
+#if defined(OCASI_BASE64_AVX2) || defined(OCASI_BASE64_SSE2)
+        // A vector, that contains invalid characters, is left to the scalar loop, which reports the exact position
+        while (position + VECTOR_WIDTH <= lastGroup && outPosition + VECTOR_OUTPUT_SIZE <= out.size())
+        {
+            if (!DecodeVector(data.data() + position, out.data() + outPosition))
+                break;
+
+            position += VECTOR_WIDTH;
+            outPosition += VECTOR_WIDTH / GROUP_SIZE * DECODED_GROUP_SIZE;
+        }
+#endif
+
+        for (; position < lastGroup; position += GROUP_SIZE, outPosition += DECODED_GROUP_SIZE)
+            DecodeGroup(data, position, out.data() + outPosition);
+
+        // Padding is only allowed for the last one or two characters
+        uint8_t values[GROUP_SIZE];
+        size_t paddingCount = 0;
+        for (size_t i = 0; i < GROUP_SIZE; i++)
+        {
+            values[i] = DECODING_TABLE[(uint8_t) data[lastGroup + i]];
+            if (values[i] == PADDING_CHARACTER && i >= 2)
+            {
+                values[i] = 0;
+                paddingCount++;
+            }
+            else if ((values[i] & INVALID_CHARACTER) || paddingCount > 0)
+                ThrowInvalidCharacter(data, lastGroup + i);
+        }
+
+        uint32_t group = (values[0] << 18) | (values[1] << 12) | (values[2] << 6) | values[3];
+        uint8_t decoded[DECODED_GROUP_SIZE] = { (uint8_t) (group >> 16), (uint8_t) (group >> 8), (uint8_t) group };
+        std::memcpy(out.data() + outPosition, decoded, DECODED_GROUP_SIZE - paddingCount);
+
+        return outPosition + DECODED_GROUP_SIZE - paddingCount;
+    }
+
+    std::vector<uint8_t> DecodeBase64(std::string_view data)
+    {
+        std::vector<uint8_t> out(GetBase64DecodedSize(data));
+        DecodeBase64(data, out);
+        return out;
+    }
+
+    std::string_view GetBase64DataURIPayload(std::string_view uri)
+    {
+        constexpr std::string_view BASE64_MARKER = ";base64,";
+
+        size_t separator = uri.find(',');
+        if (uri.substr(0, 5) != "data:" || separator == std::string_view::npos || separator + 1 < BASE64_MARKER.size() ||
+            uri.substr(separator + 1 - BASE64_MARKER.size(), BASE64_MARKER.size()) != BASE64_MARKER)
+            throw FailedImportError("Only base64 encoded data uris are supported.");
+
+        return uri.substr(separator + 1);
+    }
+
+}
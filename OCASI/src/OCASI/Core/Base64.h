@@ -0,0 +1,36 @@
+#pragma once
+
+#include "OCASI/Core/Base.h"
+
+#include <span>
+#include <string_view>
+
+namespace OCASI::Util {
+
+    //! @brief Returns the name of the vector instruction set, that the base64 decoder was compiled for.
+    const char* GetBase64InstructionSet();
+
+    //! @brief Returns the number of bytes, that the padded base64 data decodes to.
+    size_t GetBase64DecodedSize(std::string_view data);
+
+    /*! @brief Decodes padded base64 data into a caller provided buffer.
+     *
+     *  The data is translated and validated a vector register at a time, the last group and invalid input are handled
+     *  by the scalar decoder.
+     *  @param out The output buffer. It has to hold at least GetBase64DecodedSize(data) bytes.
+     *  @return The number of decoded bytes.
+     *  @throws FailedImportError If the data contains invalid characters, its size is not a multiple of 4, or the output
+     *          buffer is too small.
+     */
+    size_t DecodeBase64(std::string_view data, std::span<uint8_t> out);
+
+    //! @brief Decodes padded base64 data into a new vector. See DecodeBase64(std::string_view, std::span<uint8_t>).
+    std::vector<uint8_t> DecodeBase64(std::string_view data);
+
+    /*! @brief Returns the base64 encoded payload of a data uri (data:[<mime type>];base64,<data>) as a view into the uri.
+     *
+     *  @throws FailedImportError If the uri is not a base64 encoded data uri.
+     */
+    std::string_view GetBase64DataURIPayload(std::string_view uri);
+
+}
@@ -24,5 +24,7 @@ namespace OCASI {
         virtual std::string_view GetLoggerPattern() const = 0;
         virtual const std::vector<std::string_view> GetSupportedFileExtensions()  const = 0;
         virtual ImporterType GetImporterType() const = 0;
+        //! @brief Has to be increased, whenever the importer's output changes, so that cached scenes are imported again.
+        virtual uint32_t GetImporterVersion() const = 0;
     };
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 
 namespace OCASI {
     struct Scene;
+    struct Mesh;
     class BaseImporter;
     
     class BasePostProcess
@@ -21,8 +22,16 @@ namespace OCASI {
         BasePostProcess() = default;
         virtual ~BasePostProcess() = default;
         
+        //! @brief Whether the process applies to files of the importer at all, regardless of the meshes in the scene.
+        virtual bool SupportsImporter(const BaseImporter&) const { return true; }
         virtual bool NeedsProcessing(SharedPtr<Scene> scene, SharedPtr<BaseImporter> importer) = 0;
         virtual void ExecuteProcess() = 0;
+        /*! @brief Applies the process to a single mesh, if the mesh needs it.
+         *
+         *  Used for meshes, whose geometry is loaded after the import (see Mesh::LoadGeometry()). Meshes may be loaded from
+         *  multiple threads at the same time, so this must not modify the state of the process.
+         */
+        virtual void ProcessMesh(Mesh& mesh) = 0;
         
         virtual PostProcessorOptions GetProcessType() const = 0;
     protected:
@@ -3,41 +3,49 @@
 namespace OCASI {
 
     BinaryReader::BinaryReader(FileReader &reader)
-        : m_DataSize(reader.GetFileSize())
+        : BinaryReader(reader.GetFileSpan())
+    {
+    }
+
+    BinaryReader::BinaryReader(std::span<const uint8_t> data)
+        : m_Data(data.data()), m_DataSize(data.size())
     {
-        m_Data = reader.GetFileDataInBytes();
     }
 
     BinaryReader::BinaryReader(uint8_t* data, size_t dataSize)
         : m_DataSize(dataSize)
     {
         OCASI_ASSERT(data);
-        m_Data = new uint8_t[m_DataSize];
-        std::memcpy(m_Data, data, m_DataSize);
+        m_OwnedData.assign(data, data + dataSize);
+        m_Data = m_OwnedData.data();
     }
 
     BinaryReader::BinaryReader(std::vector<uint8_t> &data)
-        : m_DataSize(data.size())
+        : m_DataSize(data.size()), m_OwnedData(data)
     {
         OCASI_ASSERT(!data.empty());
-        m_Data = new uint8_t[m_DataSize];
-        std::memcpy(m_Data, data.data(), m_DataSize);
-    }
-
-    BinaryReader::~BinaryReader()
-    {
-        delete m_Data;
+        m_Data = m_OwnedData.data();
     }
 
     uint8_t* BinaryReader::Get(size_t size)
     {
-        OCASI_ASSERT(m_Pointer < m_DataSize);
+        OCASI_ASSERT(m_Pointer + size <= m_DataSize);
         uint8_t* data = new uint8_t[size];
         std::memcpy(data, m_Data + m_Pointer, size);
         m_Pointer += size;
         return data;
     }
 
+    std::span<const uint8_t> BinaryReader::GetSpan(size_t size)
+    {
+        if (m_Pointer + size > m_DataSize)
+            throw FailedImportError(FORMAT("Cannot read {} bytes at offset {}, as the data is only {} bytes long.", size, m_Pointer, m_DataSize));
+
+        std::span<const uint8_t> data(m_Data + m_Pointer, size);
+        m_Pointer += size;
+        return data;
+    }
+
     uint8_t BinaryReader::GetByte()
     {
         return GetType<uint8_t>();
@@ -7,15 +7,18 @@ namespace OCASI {
     class BinaryReader
     {
     public:
+        //! @brief Reads directly from the readers file data, without copying it.
         BinaryReader(FileReader& reader);
+        //! @brief Reads directly from the span, without copying it. The data must outlive the reader.
+        BinaryReader(std::span<const uint8_t> data);
         BinaryReader(uint8_t* data, size_t dataSize);
         BinaryReader(std::vector<uint8_t>& data);
-        ~BinaryReader();
+        ~BinaryReader() = default;
 
         template<typename T>
         T GetType()
         {
-            OCASI_ASSERT(m_Pointer < m_DataSize);
+            OCASI_ASSERT(m_Pointer + sizeof(T) <= m_DataSize);
             T type;
             std::memcpy(&type, m_Data + m_Pointer, sizeof(T));
             m_Pointer += sizeof(T);
@@ -23,6 +26,8 @@ namespace OCASI {
         }
 
         uint8_t * Get(size_t size);
+        //! @brief Returns a view of the next size bytes and advances the pointer, without copying the data.
+        std::span<const uint8_t> GetSpan(size_t size);
 
         uint8_t GetByte();
         char GetChar();
@@ -48,10 +53,15 @@ namespace OCASI {
         void SetPointer(size_t pointer) { m_Pointer = pointer; }
         void MovePointer(size_t moveAmount) { m_Pointer += moveAmount; }
 
+        size_t GetDataSize() const { return m_DataSize; }
+
     private:
-        uint8_t* m_Data = nullptr;
+        const uint8_t* m_Data = nullptr;
         size_t m_DataSize = 0;
 
+        // Only used, when the reader was constructed from data it has to copy
+        std::vector<uint8_t> m_OwnedData;
+
         size_t m_Pointer = 0;
     };
 
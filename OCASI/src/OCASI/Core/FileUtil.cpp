@@ -1,15 +1,192 @@
 #include "FileUtil.h"
 
 #include "OCASI/Core/StringUtil.h"
+#include "OCASI/Core/TextScanner.h"
+
+#include <fstream>
+#include <algorithm>
+
+#ifdef OCASI_PLATFORM_WINDOWS
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#elif defined(OCASI_PLATFORM_LINUX)
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
 
 namespace OCASI {
 
+    // The fallback buffer is padded as well, so readers can rely on GetReadablePadding() for unmapped files
+    constexpr size_t FALLBACK_READ_PADDING = 64;
+
+    static size_t GetPageSize()
+    {
+#ifdef OCASI_PLATFORM_WINDOWS
+        SYSTEM_INFO systemInfo;
+        GetSystemInfo(&systemInfo);
+        return (size_t) systemInfo.dwPageSize;
+#elif defined(OCASI_PLATFORM_LINUX)
+        return (size_t) sysconf(_SC_PAGESIZE);
+#else
+        return 0;
+#endif
+    }
+
+    MappedFile::MappedFile(const Path& path)
+    {
+#ifdef OCASI_PLATFORM_WINDOWS
+        HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize))
+        {
+            CloseHandle(file);
+            return;
+        }
+
+        m_FileHandle = file;
+        m_Size = (size_t) fileSize.QuadPart;
+        m_Open = true;
+
+        // Mapping a file with a size of 0 is not allowed
+        if (m_Size == 0)
+            return;
+
+        m_MappingHandle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_MappingHandle)
+        {
+            void* view = MapViewOfFile(m_MappingHandle, FILE_MAP_READ, 0, 0, 0);
+            if (view)
+            {
+                m_Data = static_cast<const uint8_t*>(view);
+                m_Mapped = true;
+                m_ReadablePadding = GetPageSize() - 1 - (m_Size - 1) % GetPageSize();
+                return;
+            }
+        }
+#elif defined(OCASI_PLATFORM_LINUX)
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return;
+
+        struct stat fileStat = {};
+        if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+        {
+            close(fd);
+            return;
+        }
+
+        m_Size = (size_t) fileStat.st_size;
+        m_Open = true;
+
+        // Mapping a file with a size of 0 is not allowed
+        if (m_Size == 0)
+        {
+            close(fd);
+            return;
+        }
+
+        void* view = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping stays valid after the file descriptor is closed
+        close(fd);
+
+        if (view != MAP_FAILED)
+        {
+            m_Data = static_cast<const uint8_t*>(view);
+            m_Mapped = true;
+            m_ReadablePadding = GetPageSize() - 1 - (m_Size - 1) % GetPageSize();
+            return;
+        }
+#endif
+        ReadWithoutMapping(path);
+    }
+
+    MappedFile::~MappedFile()
+    {
+#ifdef OCASI_PLATFORM_WINDOWS
+        if (m_Mapped)
+            UnmapViewOfFile(m_Data);
+        if (m_MappingHandle)
+            CloseHandle(m_MappingHandle);
+        if (m_FileHandle)
+            CloseHandle(m_FileHandle);
+#elif defined(OCASI_PLATFORM_LINUX)
+        if (m_Mapped)
+            munmap(const_cast<uint8_t*>(m_Data), m_Size);
+#endif
+    }
+
+    void MappedFile::Advise(MemoryAccessHint hint, size_t offset, size_t size) const
+    {
+        if (!m_Mapped || offset >= m_Size)
+            return;
+
+        size = std::min(size, m_Size - offset);
+
+#ifdef OCASI_PLATFORM_LINUX
+        int advice = MADV_NORMAL;
+        switch (hint)
+        {
+            case MemoryAccessHint::Normal:
+                advice = MADV_NORMAL;
+                break;
+            case MemoryAccessHint::Sequential:
+                advice = MADV_SEQUENTIAL;
+                break;
+            case MemoryAccessHint::Random:
+                advice = MADV_RANDOM;
+                break;
+            case MemoryAccessHint::WillNeed:
+                advice = MADV_WILLNEED;
+                break;
+        }
+
+        // madvise requires a page aligned address
+        const size_t pageSize = GetPageSize();
+        size_t alignedOffset = offset - offset % pageSize;
+        madvise(const_cast<uint8_t*>(m_Data) + alignedOffset, size + offset - alignedOffset, advice);
+#elif defined(OCASI_PLATFORM_WINDOWS)
+        // Windows only supports prefetching, the sequential scan hint is already given when opening the file
+        if (hint == MemoryAccessHint::WillNeed)
+        {
+            WIN32_MEMORY_RANGE_ENTRY range = { const_cast<uint8_t*>(m_Data) + offset, size };
+            PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+        }
+#endif
+    }
+
+    void MappedFile::ReadWithoutMapping(const Path& path)
+    {
+        std::ifstream stream(path, std::ios::binary | std::ios::ate);
+        if (!stream.is_open())
+            return;
+
+        m_Size = (size_t) stream.tellg();
+        stream.seekg(0, std::ios::beg);
+
+        m_FallbackData.resize(m_Size + FALLBACK_READ_PADDING);
+        stream.read(reinterpret_cast<char*>(m_FallbackData.data()), (std::streamsize) m_Size);
+
+        m_Data = m_FallbackData.data();
+        m_ReadablePadding = FALLBACK_READ_PADDING;
+        m_Open = true;
+    }
+
     FileReader::FileReader(const Path &path, bool isBinary)
-        : m_Path(path), m_Binary(isBinary), m_FileReader(m_Path, std::ios::binary)//m_FileReader(m_Path, m_Binary ? std::ios::binary : std::ios::in)
+        : m_Path(path), m_Binary(isBinary), m_MappedFile(MakeShared<MappedFile>(m_Path))
+    {
+        m_Data = m_MappedFile->GetSpan();
+        m_FileSize = m_Data.size();
+    }
+
+    FileReader::FileReader(std::span<const uint8_t> data, const Path& path, FileResolver resolver)
+        : m_Path(path), m_Binary(false), m_Data(data), m_MemoryFile(true), m_Resolver(std::move(resolver)), m_FileSize(data.size())
     {
-        m_FileReader.seekg(0, std::ios::end);
-        m_FileSize = m_FileReader.tellg();
-        m_FileReader.seekg(0, std::ios::beg);
     }
 
     FileReader::~FileReader() {
@@ -17,82 +194,132 @@ namespace OCASI {
             Close();
     }
 
+    FileReader FileReader::OpenRelative(const Path& relativePath, bool isBinary) const
+    {
+        Path path = m_Path.has_parent_path() ? m_Path.parent_path() / relativePath : relativePath;
+
+        if (!m_MemoryFile)
+        {
+            if (m_OpenedFiles)
+            {
+                std::lock_guard lock(m_OpenedFiles->Mutex);
+                m_OpenedFiles->Paths.push_back(path);
+            }
+
+            FileReader reader(path, isBinary);
+            reader.TrackOpenedFiles(m_OpenedFiles);
+            return reader;
+        }
+
+        if (auto data = ResolveRelative(relativePath))
+            return FileReader(*data, path, m_Resolver);
+
+        FileReader unresolved({}, path, m_Resolver);
+        unresolved.Close();
+        return unresolved;
+    }
+
+    std::optional<std::span<const uint8_t>> FileReader::ResolveRelative(const Path& relativePath) const
+    {
+        if (!m_MemoryFile || !m_Resolver)
+            return std::nullopt;
+
+        return m_Resolver(relativePath);
+    }
+
     bool FileReader::NextLine(std::string& outLine)
     {
-        return std::getline(m_FileReader, outLine).operator bool();
+        std::string_view line;
+        bool r = NextLineView(line);
+        outLine.assign(line);
+        return r;
     }
 
     bool FileReader::NextLineC(std::vector<char>& outLine)
     {
-        std::string line;
-        bool r = std::getline(m_FileReader, line).operator bool();
-        outLine.resize(line.size());
+        std::string_view line;
+        bool r = NextLineView(line);
         outLine.assign(line.begin(), line.end());
         return r;
     }
 
+    bool FileReader::NextLineView(std::string_view& outLine)
+    {
+        if (HasReachedEOF())
+        {
+            outLine = {};
+            return false;
+        }
+
+        std::string_view remaining = GetFileView().substr(m_Pointer);
+        const char* lineEnd = Util::FindChar(remaining.data(), remaining.data() + remaining.size(), '\n');
+
+        outLine = { remaining.data(), (size_t) (lineEnd - remaining.data()) };
+        m_Pointer = std::min(m_Pointer + outLine.size() + 1, m_Data.size());
+        return true;
+    }
+
     void FileReader::Close()
     {
-        m_FileReader.close();
+        m_MappedFile = nullptr;
+        m_MemoryFile = false;
+        m_Data = {};
+        m_Pointer = 0;
     }
 
     void FileReader::Reset()
     {
-        m_FileReader.clear();
-        m_FileReader.seekg(0);
+        m_Pointer = 0;
     }
 
     uint8_t* FileReader::GetFileDataInBytes()
     {
-        m_FileReader.unsetf(std::ios::skipws);
         uint8_t* out = new uint8_t[m_FileSize];
-        m_FileReader.read((char*) out, m_FileSize);
+        std::memcpy(out, m_Data.data(), m_FileSize);
 
         return out;
     }
 
     std::string FileReader::GetFileString()
     {
-        m_FileReader.unsetf(std::ios::skipws);
-        std::string out;
-        out.resize(m_FileSize);
-        m_FileReader.read(out.data(), m_FileSize);
-
-        return out;
+        return std::string(GetFileView());
     }
 
     std::vector<uint8_t> FileReader::GetBytes(size_t size) {
-        m_FileReader.unsetf(std::ios::skipws);
-        if (size < m_FileSize)
+        if (m_Pointer + size > m_Data.size())
             return {};
 
-        std::vector<uint8_t > data;
-        data.resize(size);
-        m_FileReader.read(reinterpret_cast<char*>(data.data()), size);
+        std::vector<uint8_t> data(m_Data.begin() + m_Pointer, m_Data.begin() + m_Pointer + size);
+        m_Pointer += size;
         return data;
     }
 
     void FileReader::GetBytes(void* outData, size_t size)
     {
-        m_FileReader.unsetf(std::ios::skipws);
-        if (size > m_FileSize)
+        if (m_Pointer + size > m_Data.size())
             return;
 
-        m_FileReader.read((char*)outData, (std::streamsize) size);
+        std::memcpy(outData, m_Data.data() + m_Pointer, size);
+        m_Pointer += size;
     }
 
     void FileReader::Set0()
     {
-        m_FileReader.seekg(0, std::ios::beg);
+        m_Pointer = 0;
     }
-    
+
     void FileReader::SetBinary()
     {
+        // The mapping is always binary, so there is nothing to reopen
         m_Binary = true;
-        m_FileReader.close();
-        m_FileReader.open(m_Path, std::ios::binary);
     }
-    
+
+    void FileReader::Advise(MemoryAccessHint hint) const
+    {
+        if (m_MappedFile)
+            m_MappedFile->Advise(hint);
+    }
+
     namespace Util {
 
         bool FindTokensInFirst100Lines(OCASI::FileReader& reader, const std::vector<std::string>& tokens)
@@ -115,4 +342,4 @@ namespace OCASI {
             return false;
         }
     }
-}
\ No newline at end of file
+}
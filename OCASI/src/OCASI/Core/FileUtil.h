@@ -2,26 +2,137 @@
 
 #include "OCASI/Core/Base.h"
 
-#include <fstream>
+#include <span>
+#include <string_view>
+#include <optional>
+#include <functional>
+#include <mutex>
 
 namespace OCASI {
 
+    //! @brief Access pattern hints, that are forwarded to the operating system for memory mapped files.
+    enum class MemoryAccessHint
+    {
+        Normal = 0,
+        //! The mapping will be read front to back, so the kernel can read ahead aggressively.
+        Sequential,
+        //! The mapping will be read in no particular order, read ahead is disabled.
+        Random,
+        //! The mapping will be needed soon, so the kernel can start paging it in.
+        WillNeed
+    };
+
+    /*! @brief A read-only memory mapping of a file.
+     *
+     *  The file contents are exposed as a span that points directly into the page cache, so nothing is copied into
+     *  heap buffers. If the platform cannot map the file, the contents are read into an owned buffer instead and the
+     *  same span interface is exposed. Mappings are shared between consumers using a SharedPtr, so that data
+     *  referencing the mapping (e.g. glTF buffers) can outlive the FileReader, that opened the file.
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile(const Path& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /*! @brief Forwards an access pattern hint for a byte range of the mapping to the operating system.
+         *
+         *  @param hint The expected access pattern.
+         *  @param offset The byte offset into the file, at which the range starts.
+         *  @param size The byte size of the range. Clamped to the end of the file.
+         */
+        void Advise(MemoryAccessHint hint, size_t offset = 0, size_t size = SIZE_MAX) const;
+
+        bool IsOpen() const { return m_Open; }
+        bool IsMapped() const { return m_Mapped; }
+        std::span<const uint8_t> GetSpan() const { return { m_Data, m_Size }; }
+        size_t GetSize() const { return m_Size; }
+        /*! @brief Returns the number of bytes behind the end of the file data, that can be read without faulting.
+         *
+         *  Mappings end on a page boundary and the rest of the last page reads as zeros. Parsers reading past the end of
+         *  their input, like simdjson, can use these bytes as padding instead of copying the file.
+         */
+        size_t GetReadablePadding() const { return m_ReadablePadding; }
+
+    private:
+        void ReadWithoutMapping(const Path& path);
+    private:
+        const uint8_t* m_Data = nullptr;
+        size_t m_Size = 0;
+        size_t m_ReadablePadding = 0;
+
+        bool m_Open = false;
+        bool m_Mapped = false;
+
+        // Only used, when the file could not be mapped
+        std::vector<uint8_t> m_FallbackData;
+
+#ifdef OCASI_PLATFORM_WINDOWS
+        void* m_FileHandle = nullptr;
+        void* m_MappingHandle = nullptr;
+#endif
+    };
+
+    /*! @brief User supplied function for resolving files referenced by an in-memory 3D file (.bin, .mtl and texture files).
+     *
+     *  The function receives the path as it is written inside the referencing file and returns the file's data, or
+     *  std::nullopt if the file cannot be resolved. The returned data is not copied and has to stay valid until the import
+     *  has finished. Texture files are resolved while materials are converted in parallel, so the function may be called
+     *  from multiple threads at the same time.
+     */
+    using FileResolver = std::function<std::optional<std::span<const uint8_t>>(const Path& relativePath)>;
+
+    //! @brief The paths of all files, that were opened through FileReader::OpenRelative() during an import.
+    struct OpenedFileList
+    {
+        std::mutex Mutex;
+        std::vector<Path> Paths;
+    };
+
+    /*! @brief Reads files through a read-only memory mapping, or from memory supplied by the user.
+     *
+     *  The line and byte reading functions advance an internal cursor over the mapped file data. Consumers, that
+     *  want to parse the whole file at once should use GetFileSpan() or GetFileView(), which do not copy any data.
+     *  Files referenced by the read file should be opened using OpenRelative(), so that in-memory files can resolve them
+     *  through their FileResolver.
+     */
     class FileReader
     {
     public:
         FileReader(const Path& path, bool isBinary = false);
+        //! @brief Reads from user supplied memory without copying it. The path is only used for its extension and for resolving relative files.
+        FileReader(std::span<const uint8_t> data, const Path& path, FileResolver resolver = nullptr);
         ~FileReader();
 
+        /*! @brief Opens a file relative to this file's parent directory. In-memory files use their FileResolver for this.
+         *
+         *  @return The reader for the relative file. It is not open, if the file could not be found or resolved.
+         */
+        FileReader OpenRelative(const Path& relativePath, bool isBinary = false) const;
+        /*! @brief Resolves a relative file through the FileResolver of an in-memory file.
+         *
+         *  @return The file data or std::nullopt, if this is not an in-memory file or the file could not be resolved.
+         */
+        std::optional<std::span<const uint8_t>> ResolveRelative(const Path& relativePath) const;
+        //! @brief Records every file opened through OpenRelative() by this reader and the readers it opens into the list.
+        void TrackOpenedFiles(SharedPtr<OpenedFileList> list) { m_OpenedFiles = std::move(list); }
+
         bool NextLine(std::string& outLine);
         bool NextLineC(std::vector<char>& outChars);
-        
+        //! @brief Returns the next line as a view into the file data, without the line feed character.
+        bool NextLineView(std::string_view& outLine);
+
         void Close();
         void Reset();
         void SetBinary();
-        
-        bool HasReachedEOF() const { return m_FileReader.eof(); }
-        bool IsOpen() const { return m_FileReader.is_open(); }
-        
+
+        bool HasReachedEOF() const { return m_Pointer >= m_Data.size(); }
+        bool IsOpen() const { return m_MappedFile ? m_MappedFile->IsOpen() : m_MemoryFile; }
+        bool IsMemoryFile() const { return m_MemoryFile; }
+
         uint8_t* GetFileDataInBytes();
         std::string GetFileString();
         std::vector<uint8_t> GetBytes(size_t size);
@@ -37,6 +148,19 @@ namespace OCASI {
             return out;
         }
 
+        //! @brief Forwards an access pattern hint for the whole file to the operating system.
+        void Advise(MemoryAccessHint hint) const;
+
+        //! @brief Returns the whole file as a read-only span. The span is valid as long as the mapped file is alive.
+        std::span<const uint8_t> GetFileSpan() const { return m_Data; }
+        //! @brief Returns the whole file as a read-only string view. The view is valid as long as the mapped file is alive.
+        std::string_view GetFileView() const { return { reinterpret_cast<const char*>(m_Data.data()), m_Data.size() }; }
+        //! @brief Returns the mapping backing this reader or nullptr for in-memory files. Copies of the pointer keep the
+        //!        file data alive after the reader is closed.
+        const SharedPtr<MappedFile>& GetMappedFile() const { return m_MappedFile; }
+        //! @brief Returns the number of readable bytes behind the end of the file data. Always 0 for in-memory files.
+        size_t GetReadablePadding() const { return m_MappedFile ? m_MappedFile->GetReadablePadding() : 0; }
+
         explicit operator bool() const
         {
             return IsOpen();
@@ -50,14 +174,22 @@ namespace OCASI {
     private:
         Path m_Path;
         bool m_Binary;
-        std::ifstream m_FileReader;
-        size_t m_FileSize;
+
+        SharedPtr<MappedFile> m_MappedFile = nullptr;
+        std::span<const uint8_t> m_Data;
+
+        bool m_MemoryFile = false;
+        FileResolver m_Resolver = nullptr;
+        SharedPtr<OpenedFileList> m_OpenedFiles = nullptr;
+
+        size_t m_Pointer = 0;
+        size_t m_FileSize = 0;
     };
-    
+
     namespace Util {
-        
+
         bool FindTokensInFirst100Lines(OCASI::FileReader& reader, const std::vector<std::string>& tokens);
-        
+
     }
 
-}
\ No newline at end of file
+}
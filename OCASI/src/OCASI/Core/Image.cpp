@@ -34,7 +34,27 @@ namespace OCASI {
         m_ImageData.Data = std::move(data);
     }
     
-    bool Image::LoadImageFromDisk()
+    namespace {
+
+        // Copies the pixels decoded by stb_image into the image data and frees them
+        bool StoreDecodedImage(stbi_uc* data, int width, int height, int channels, ImageData& outImageData)
+        {
+            if (!data)
+                return false;
+
+            size_t size = (size_t) width * height * channels;
+            outImageData.Data.assign(data, data + size);
+            outImageData.Width = (uint32_t) width;
+            outImageData.Height = (uint32_t) height;
+            outImageData.Channels = (uint8_t) channels;
+
+            stbi_image_free(data);
+            return true;
+        }
+
+    }
+
+    bool Image::LoadImageFromDisk(bool flipVertically)
     {
         if (m_MemoryImage)
         {
@@ -42,24 +62,15 @@ namespace OCASI {
             return false;
         }
 
-        stbi_set_flip_vertically_on_load(true);
-
-        stbi_uc* data = stbi_load(m_ImagePath.string().c_str(), (int*) &m_ImageData.Width, (int*) &m_ImageData.Height, (int*) &m_ImageData.Channels, 0);
-
-        if(data)
-        {
-            uint32_t size = m_ImageData.Width * m_ImageData.Height * m_ImageData.Channels;
-            m_ImageData.Data.resize(size);
+        // The global stbi_set_flip_vertically_on_load() would race with images decoded on other threads
+        stbi_set_flip_vertically_on_load_thread(flipVertically);
 
-            std::memcpy(m_ImageData.Data.data(), data, size);
-
-            stbi_image_free(data);
-            return true;
-        }
-        return false;
+        int width = 0, height = 0, channels = 0;
+        stbi_uc* data = stbi_load(m_ImagePath.string().c_str(), &width, &height, &channels, 0);
+        return StoreDecodedImage(data, width, height, channels, m_ImageData);
     }
     
-    bool Image::LoadImageFromMemory()
+    bool Image::LoadImageFromMemory(bool flipVertically)
     {
         if (!m_MemoryImage)
         {
@@ -67,38 +78,26 @@ namespace OCASI {
             return false;
         }
 
-        stbi_set_flip_vertically_on_load(true);
-        
+        stbi_set_flip_vertically_on_load_thread(flipVertically);
         
         OCASI_ASSERT(!m_ImageData.Data.empty());
-        stbi_uc* data = stbi_load_from_memory((stbi_uc*)m_ImageData.Data.data(), (int) m_ImageData.Data.size(), (int*) &m_ImageData.Width, (int*) &m_ImageData.Height, (int*) &m_ImageData.Channels, 0);
-
-        if(data)
-        {
-            uint32_t size = m_ImageData.Width * m_ImageData.Height * m_ImageData.Channels;
-            m_ImageData.Data.clear();
-            m_ImageData.Data.resize(size);
-
-            std::memcpy(m_ImageData.Data.data(), data, size);
-
-            stbi_image_free(data);
-            return true;
-        }
-        return false;
+        int width = 0, height = 0, channels = 0;
+        stbi_uc* data = stbi_load_from_memory((stbi_uc*)m_ImageData.Data.data(), (int) m_ImageData.Data.size(), &width, &height, &channels, 0);
+        return StoreDecodedImage(data, width, height, channels, m_ImageData);
     }
     
-    const ImageData* Image::Load()
+    const ImageData* Image::Load(bool flipVertically)
     {
         if (m_MemoryImage)
         {
-            if(!LoadImageFromMemory())
+            if(!LoadImageFromMemory(flipVertically))
             {
                 return nullptr;
                 
             }
             
         }
-        else if(!LoadImageFromDisk())
+        else if(!LoadImageFromDisk(flipVertically))
             return nullptr;
 
         return &m_ImageData;
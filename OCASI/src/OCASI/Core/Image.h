@@ -97,19 +97,23 @@ namespace OCASI {
         // If the image is not a memory image, it's data can be loaded with this function;
         /*! @brief Loads an image from disk and decodes the data, if the image is not a memory image.
          *
+         *  @param flipVertically Whether the first row of the output is the bottom row of the image. The setting only
+         *                        applies to this call, so different images may be loaded on different threads at once.
          *  @return Whether image loading was successful.
          */
-        bool LoadImageFromDisk();
+        bool LoadImageFromDisk(bool flipVertically = true);
         /*! @brief Loads an image from disk and decodes the data, if the image is a memory image.
          *
+         *  @param flipVertically See LoadImageFromDisk().
          *  @return Whether image loading was successful.
          */
-        bool LoadImageFromMemory();
+        bool LoadImageFromMemory(bool flipVertically = true);
         /*! @brief Loads an image from disk or memory.
          *
+         *  @param flipVertically See LoadImageFromDisk().
          *  @return The loaded image data.
          */
-        const ImageData* Load();
+        const ImageData* Load(bool flipVertically = true);
 
         bool IsMemoryImage() const { return m_MemoryImage; }
         bool IsLoaded() const { return m_ImageData.Width != 0 && m_ImageData.Height != 0 && m_ImageData.Channels != 0; }
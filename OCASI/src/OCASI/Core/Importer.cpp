@@ -3,8 +3,13 @@
 #include "OCASI/Importers/OBJ/ObjImporter.h"
 #include "OCASI/Importers/GLTF2/GLTFImporter.h"
 #include "OCASI/Core/PostProcessor.h"
+#include "OCASI/Core/ThreadPool.h"
+#include "OCASI/Core/SceneCache.h"
 
 #include <unordered_map>
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
 
 #define CAN_LOAD(x, fName) if(!x.CanLoad()) { OCASI_LOG_ERROR("Can't load file as CanLoad() for {} did not succeed.", fName); return nullptr; }
 
@@ -12,6 +17,11 @@ namespace OCASI {
     
     std::vector<SharedPtr<BaseImporter>> Importer::s_Importers;
     PostProcessorOptions Importer::s_GlobalPostProcessingOptions = PostProcessorOptions::None;
+    Path Importer::s_SceneCacheDirectory;
+    bool Importer::s_StoreDecodedTextures = false;
+    bool Importer::s_KeepQuantizedVertexData = false;
+    bool Importer::s_LazyGeometryLoading = false;
+    bool Importer::s_ShareVertexData = false;
 
     void Importer::SetImporters()
     {
@@ -23,36 +33,67 @@ namespace OCASI {
 
     std::shared_ptr<Scene> Importer::Load3DFile(const Path& path, PostProcessorOptions options)
     {
-        if (s_Importers.empty())
-            SetImporters();
-        
         if(!exists(path))
         {
             OCASI_FAIL("Requested file does not exist. Verify the 3D model path.");
             return nullptr;
         }
 
+        FileReader reader(path);
+        if (!s_SceneCacheDirectory.empty())
+            return LoadCached(reader, options);
+
+        return Load(reader, options);
+    }
+    
+    std::shared_ptr<Scene> Importer::Load3DFromMemory(std::span<const uint8_t> data, std::string_view formatHint, PostProcessorOptions options,
+                                                      const FileResolver& resolver)
+    {
+        std::string extension(formatHint);
+        if (!extension.empty() && extension.front() != '.')
+            extension.insert(extension.begin(), '.');
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char) std::tolower(c); });
+        
+        // The path is never opened. It is only used for selecting the importer by its extension.
+        FileReader reader(data, Path(FORMAT("memory{}", extension)), resolver);
+        return Load(reader, options);
+    }
+    
+    SharedPtr<BaseImporter> Importer::FindImporter(const Path& path)
+    {
+        if (s_Importers.empty())
+            SetImporters();
+        
+        // Getting the model importer by checking for the supported importer file extensions
+        std::string fExtension = path.extension().string();
+        SharedPtr<BaseImporter> importer = nullptr;
+        for (auto& imp : s_Importers)
+        {
+            auto availableExtensions = imp->GetSupportedFileExtensions();
+            if (std::find(availableExtensions.begin(), availableExtensions.end(), fExtension) != availableExtensions.end())
+                importer = imp;
+        }
+        
+        return importer;
+    }
+    
+    std::shared_ptr<Scene> Importer::Load(FileReader& reader, PostProcessorOptions options)
+    {
+        if (s_Importers.empty())
+            SetImporters();
+
+        const Path& path = reader.GetPath();
         std::string fExtension = path.extension().string();
         std::shared_ptr<Scene> result = nullptr;
 
         try
         {
-            // Getting the model importer by checking for the supported importer file extensions
-            SharedPtr<BaseImporter> importer = nullptr;
-            for (auto& imp : s_Importers)
-            {
-                auto availableExtensions = imp->GetSupportedFileExtensions();
-                if (std::find(availableExtensions.begin(), availableExtensions.end(), std::string(fExtension)) != availableExtensions.end())
-                    importer = imp;
-            }
-            
+            SharedPtr<BaseImporter> importer = FindImporter(path);
             if (!importer)
                 throw FailedImportError(FORMAT("Could not find importer supporting {} file extension.", fExtension));
             
             Logger::SetLoggerName(std::string(importer->GetLoggerPattern()));
             
-            FileReader reader(path);
-            
             if (!importer->CanLoad(reader))
                 throw FailedImportError("Cannot load file, as it failed to be validated.");
             
@@ -69,6 +110,19 @@ namespace OCASI {
             OCASI_LOG_ERROR(FORMAT("Failed to load {}: {}", path.string(), e.what()));
             result = nullptr;
         }
+        catch (const std::bad_alloc&)
+        {
+            // Element counts, that are not backed by data (e.g. glTF accessors without a buffer view), can still exceed the memory
+            Logger::ResetLoggerName();
+            OCASI_LOG_ERROR(FORMAT("Failed to load {}: Ran out of memory.", path.string()));
+            result = nullptr;
+        }
+        catch (const std::length_error&)
+        {
+            Logger::ResetLoggerName();
+            OCASI_LOG_ERROR(FORMAT("Failed to load {}: The file declares more elements than can be stored.", path.string()));
+            result = nullptr;
+        }
         Logger::ResetLoggerName();
         
         OCASI_ASSERT(result);
@@ -76,8 +130,70 @@ namespace OCASI {
         return result;
     }
     
+    std::shared_ptr<Scene> Importer::LoadCached(FileReader& reader, PostProcessorOptions options)
+    {
+        // A cached scene always contains its geometry, which would defeat lazy loading, and stores every mesh on its own
+        SharedPtr<BaseImporter> importer = FindImporter(reader.GetPath());
+        if (!importer || !reader.IsOpen() || s_LazyGeometryLoading || s_ShareVertexData)
+            return Load(reader, options);
+        
+        SceneCacheKey key = {};
+        key.ContentHash = SceneCache::HashData(reader.GetFileSpan());
+        key.ImporterType = (uint32_t) importer->GetImporterType();
+        key.ImporterVersion = importer->GetImporterVersion();
+        key.Options = options | s_GlobalPostProcessingOptions;
+        key.KeepQuantizedVertexData = s_KeepQuantizedVertexData;
+        
+        Path cachePath = SceneCache::GetCachePath(s_SceneCacheDirectory, reader.GetPath());
+        if (auto scene = SceneCache::Read(cachePath, key))
+            return scene;
+        
+        auto openedFiles = MakeShared<OpenedFileList>();
+        reader.TrackOpenedFiles(openedFiles);
+        
+        auto scene = Load(reader, options);
+        if (scene && !SceneCache::Write(cachePath, *scene, key, openedFiles->Paths, s_StoreDecodedTextures))
+            OCASI_LOG_WARN(FORMAT("Failed to write the scene cache file {}.", cachePath.string()));
+        
+        return scene;
+    }
+    
     void Importer::SetGlobalPostProcessorOptions(PostProcessorOptions options)
     {
         s_GlobalPostProcessingOptions = options;
     }
+    
+    void Importer::SetGlobalThreadCount(uint32_t threadCount)
+    {
+        ThreadPool::SetGlobalThreadCount(threadCount);
+    }
+    
+    void Importer::SetSceneCacheDirectory(const Path& directory, bool storeDecodedTextures)
+    {
+        s_SceneCacheDirectory = directory;
+        s_StoreDecodedTextures = storeDecodedTextures;
+    }
+    
+    void Importer::SetParserPoolLimit(size_t byteSize)
+    {
+        GLTF::JsonParser::SetJsonPoolLimit(byteSize);
+    }
+    
+    void Importer::SetKeepQuantizedVertexData(bool keep)
+    {
+        s_KeepQuantizedVertexData = keep;
+        GLTFImporter::SetKeepQuantizedVertexData(keep);
+    }
+    
+    void Importer::SetLazyGeometryLoading(bool lazy)
+    {
+        s_LazyGeometryLoading = lazy;
+        GLTFImporter::SetLazyGeometryLoading(lazy);
+    }
+    
+    void Importer::SetShareVertexData(bool share)
+    {
+        s_ShareVertexData = share;
+        GLTFImporter::SetShareVertexData(share);
+    }
 }
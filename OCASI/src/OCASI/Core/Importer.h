@@ -2,6 +2,7 @@
 
 #include "OCASI/Core/Scene.h"
 #include "OCASI/Core/PostProcessorOptions.h"
+#include "OCASI/Core/FileUtil.h"
 
 namespace OCASI {
     class BaseImporter;
@@ -13,8 +14,6 @@ namespace OCASI {
     class Importer 
     {
     public:
-        // TODO: Implement a function taking the file data as a string
-        
         /*! @brief Loads a 3D model. Supported file formats are GLTF and OBJ.
          *
          * @param path Specifies the path to the 3D model file to import.
@@ -24,16 +23,101 @@ namespace OCASI {
          */
         static std::shared_ptr<Scene> Load3DFile(const Path& path, PostProcessorOptions options);
         
+        /*! @brief Loads a 3D model from memory. The data is parsed in place and is not copied.
+         *
+         * @param data The file data of the 3D model. It has to stay valid until this function returns.
+         * @param formatHint The file extension of the 3D model's format, with or without a leading dot (e.g. ".obj", "glb").
+         * @param options A bit enum flag for specifying post processing operations.
+         * @param resolver Used for resolving files referenced by the 3D model, like .bin, .mtl and texture files. When
+         *                 no resolver is specified, referenced files cannot be loaded.
+         * @return The imported scene. Nullptr if scene creation failed.
+         */
+        static std::shared_ptr<Scene> Load3DFromMemory(std::span<const uint8_t> data, std::string_view formatHint, PostProcessorOptions options,
+                                                       const FileResolver& resolver = nullptr);
+        
         /*! @brief Sets a global constant to be applied to all meshes for importing with a specific set
          *         of post processing operations.
          *
          * @param options The post processing operations to be set, in form of a enum bit flag.
          */
         static void SetGlobalPostProcessorOptions(PostProcessorOptions options);
+        
+        /*! @brief Sets the number of threads, the importers are allowed to use. Must not be called during an import.
+         *
+         * @param threadCount The number of threads including the calling thread. 1 imports everything on the calling
+         *                    thread, 0 (the default) uses one thread per hardware thread.
+         */
+        static void SetGlobalThreadCount(uint32_t threadCount);
+        
+        /*! @brief Enables caching of scenes loaded with Load3DFile().
+         *
+         *  The imported and post processed scene is stored inside the directory. As long as neither the file, nor the files
+         *  it references, the importer or the post processing options change, later imports read the cached scene instead.
+         *
+         * @param directory The directory for the cache files. It is created, if it does not exist. An empty path disables the cache.
+         * @param storeDecodedTextures Whether the textures are decoded and the pixels are stored inside the cache, so the
+         *                             images of cached scenes are already loaded.
+         */
+        static void SetSceneCacheDirectory(const Path& directory, bool storeDecodedTextures = false);
+        
+        /*! @brief Limits the memory, that is kept for reusing between imports.
+         *
+         *  Every importing thread keeps its json parsers and buffers for the next import. Parsers and buffers, that had to
+         *  grow for a larger file, are freed after the import instead.
+         *
+         * @param byteSize The largest file size in bytes, whose parser and buffer are kept (64 MB by default). 0 frees
+         *                 them after every import.
+         */
+        static void SetParserPoolLimit(size_t byteSize);
+        
+        /*! @brief Keeps vertex attributes, that are stored as integers (glTF KHR_mesh_quantization), in their quantized form.
+         *
+         *  Quantized positions, normals, tangents and texture coordinates are stored inside the Quantized* attributes of the
+         *  meshes, together with the scale and offset for dequantizing them, instead of being expanded to floats. Attributes
+         *  stored as floats are not affected. Must not be called during an import.
+         *
+         * @param keep Whether to keep quantized vertex data (false by default).
+         */
+        static void SetKeepQuantizedVertexData(bool keep);
+        
+        /*! @brief Imports glTF files without reading the vertex and index data of their meshes.
+         *
+         *  The node hierarchy, the materials and the mesh metadata (material index and face type) are returned right away.
+         *  The geometry of a mesh is read on Mesh::LoadGeometry(), which only touches the buffer ranges, that the mesh
+         *  references, and applies the post processes of the import to it. Meshes can be loaded from multiple threads and
+         *  freed again with Mesh::UnloadGeometry(). The scene keeps the .glb and .bin files mapped, until it is destroyed.
+         *  While enabled, the scene cache is not used (see SetSceneCacheDirectory()). Files loaded from memory are always
+         *  imported with their geometry, as their data only has to stay valid during the import. Must not be called during
+         *  an import.
+         *
+         * @param lazy Whether to load the geometry on request (false by default).
+         */
+        static void SetLazyGeometryLoading(bool lazy);
+        
+        /*! @brief Lets meshes, that read the same vertex data, reference a single copy of it instead of owning one each.
+         *
+         *  glTF primitives often share their vertex attribute accessors and only differ in their indices. With sharing
+         *  enabled, every such attribute is stored once inside the Shared* attributes of the meshes (see Mesh::GetVertices()),
+         *  so the memory of a scene grows with its unique vertex data. Quantized attributes, indices and lazily loaded meshes
+         *  are not shared. While enabled, the scene cache is not used (see SetSceneCacheDirectory()). Must not be called during
+         *  an import.
+         *
+         * @param share Whether to share vertex data between meshes (false by default).
+         */
+        static void SetShareVertexData(bool share);
     private:
         static void SetImporters();
+        static SharedPtr<BaseImporter> FindImporter(const Path& path);
+        static std::shared_ptr<Scene> Load(FileReader& reader, PostProcessorOptions options);
+        static std::shared_ptr<Scene> LoadCached(FileReader& reader, PostProcessorOptions options);
     private:
         static std::vector<SharedPtr<BaseImporter>> s_Importers;
         static PostProcessorOptions s_GlobalPostProcessingOptions;
+        
+        static Path s_SceneCacheDirectory;
+        static bool s_StoreDecodedTextures;
+        static bool s_KeepQuantizedVertexData;
+        static bool s_LazyGeometryLoading;
+        static bool s_ShareVertexData;
     };
 }
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "Model.h"
+
+#include "OCASI/Core/BasePostProcess.h"
+
+#include <algorithm>
+
+namespace OCASI {
+
+    void GeometrySource::Load(Mesh& mesh, size_t geometryIndex)
+    {
+        ReadGeometry(mesh, geometryIndex);
+
+        for (BasePostProcess* process : m_DeferredPostProcesses)
+            process->ProcessMesh(mesh);
+    }
+
+    void Mesh::LoadGeometry()
+    {
+        if (!GeometryPending)
+            return;
+
+        OCASI_ASSERT(Geometry);
+        Geometry->Load(*this, GeometryIndex);
+        GeometryPending = false;
+    }
+
+    void Mesh::UnloadGeometry()
+    {
+        // Meshes, that were imported with their geometry, cannot be read again
+        if (!Geometry || GeometryPending)
+            return;
+
+        // Swapping with empty containers releases the memory, which clear() would keep
+        std::vector<glm::vec3>().swap(Vertices);
+        std::vector<glm::vec3>().swap(VertexColours);
+        std::vector<glm::vec3>().swap(Normals);
+        for (auto& texCoords : TexCoords)
+            std::vector<glm::vec2>().swap(texCoords);
+        std::vector<glm::vec4>().swap(Tangents);
+        std::vector<uint32_t>().swap(Indices);
+
+        QuantizedVertices = {};
+        QuantizedNormals = {};
+        QuantizedTexCoords = {};
+        QuantizedTangents = {};
+
+        SharedVertices = nullptr;
+        SharedVertexColours = nullptr;
+        SharedNormals = nullptr;
+        SharedTexCoords = {};
+        SharedTangents = nullptr;
+
+        GeometryPending = true;
+    }
+
+    void Model::LoadGeometry()
+    {
+        for (Mesh& mesh : Meshes)
+            mesh.LoadGeometry();
+    }
+
+    bool Model::IsGeometryLoaded() const
+    {
+        return std::all_of(Meshes.begin(), Meshes.end(), [](const Mesh& mesh) { return mesh.IsGeometryLoaded(); });
+    }
+
+}
@@ -42,6 +42,57 @@ namespace OCASI {
         _3D = 3
     };
 
+    //! @brief The integer types, that quantized vertex attributes are stored with.
+    enum class QuantizedComponentType
+    {
+        None = 0,
+        Int8,
+        UInt8,
+        Int16,
+        UInt16
+    };
+
+    /*! @brief A vertex attribute, that is kept in the quantized integer form it was stored with inside the 3D file.
+     *
+     *  The components are tightly packed, so element e starts at component e * ComponentCount. A component c of an element
+     *  dequantizes to c * Scale[c] + Offset[c]. Normalized signed integers are scaled by 1 / 127 (or 1 / 32767), so their
+     *  lowest value dequantizes slightly below -1 and has to be clamped to -1.
+     */
+    struct QuantizedAttribute
+    {
+        QuantizedComponentType Type = QuantizedComponentType::None;
+        uint32_t ComponentCount = 0;
+        glm::vec4 Scale = glm::vec4(1.0f);
+        glm::vec4 Offset = glm::vec4(0.0f);
+
+        std::vector<uint8_t> Data;
+
+        bool IsEmpty() const { return Data.empty(); }
+    };
+
+    struct Mesh;
+    class BasePostProcess;
+
+    /*! @brief Reads the vertex and index data of meshes, that were imported without it (see Importer::SetLazyGeometryLoading()).
+     *
+     *  A source is shared by all meshes of a scene and keeps the file data, that the geometry is read from, alive. Different
+     *  meshes may be loaded from multiple threads at the same time.
+     */
+    class GeometrySource
+    {
+    public:
+        virtual ~GeometrySource() = default;
+
+        //! @brief Reads the geometry with the index into mesh and applies the deferred post processes to it.
+        void Load(Mesh& mesh, size_t geometryIndex);
+        //! @brief Sets the post processes, that were requested for the import, but are applied to each mesh once it is loaded.
+        void SetDeferredPostProcesses(std::vector<BasePostProcess*> processes) { m_DeferredPostProcesses = std::move(processes); }
+    protected:
+        virtual void ReadGeometry(Mesh& mesh, size_t geometryIndex) = 0;
+    private:
+        std::vector<BasePostProcess*> m_DeferredPostProcesses;
+    };
+
     /*! @brief A mesh holds vertex data of a consecutive structure represented by positions, normals, texture coordinates, vertex colours,
      *         tangents and indices.
      *
@@ -60,14 +111,50 @@ namespace OCASI {
         std::vector<glm::vec4> Tangents; // Optional
         std::vector<uint32_t> Indices;
 
+        //! Only used, if quantized vertex data is kept while importing (see Importer::SetKeepQuantizedVertexData()). An
+        //! attribute is either stored quantized or as floats, never both.
+        QuantizedAttribute QuantizedVertices;
+        QuantizedAttribute QuantizedNormals;
+        std::array<QuantizedAttribute, TEXTURE_COORDINATE_ARRAY_SIZE> QuantizedTexCoords;
+        QuantizedAttribute QuantizedTangents;
+
+        //! Only used, if vertex data is shared between meshes (see Importer::SetShareVertexData()). Attributes, that are read
+        //! from the same data by multiple meshes, are stored once and referenced by all of them, while the vectors above
+        //! stay empty. Modifying shared data modifies it for all meshes referencing it. Indices are never shared.
+        SharedPtr<std::vector<glm::vec3>> SharedVertices;
+        SharedPtr<std::vector<glm::vec3>> SharedVertexColours;
+        SharedPtr<std::vector<glm::vec3>> SharedNormals;
+        std::array<SharedPtr<std::vector<glm::vec2>>, TEXTURE_COORDINATE_ARRAY_SIZE> SharedTexCoords;
+        SharedPtr<std::vector<glm::vec4>> SharedTangents;
+
         size_t MaterialIndex = INVALID_ID;
 
         FaceType FaceMode = FaceType::None;
         Dimension Dim = Dimension::None;
+
+        //! Only set for meshes of lazily imported scenes (see Importer::SetLazyGeometryLoading()). While GeometryPending is
+        //! true, the vertex and index data is empty and LoadGeometry() has to be called before accessing it.
+        SharedPtr<GeometrySource> Geometry = nullptr;
+        size_t GeometryIndex = INVALID_ID;
+        bool GeometryPending = false;
+
+        //! @brief Reads the vertex and index data of a lazily imported mesh. Does nothing, if the data is already loaded.
+        void LoadGeometry();
+        //! @brief Frees the vertex and index data of a lazily imported mesh, so it can be loaded again later on.
+        void UnloadGeometry();
+        bool IsGeometryLoaded() const { return !GeometryPending; }
         
-        bool HasVertexColours() const { return !VertexColours.empty(); }
-        bool HasNormals() const { return !Normals.empty(); }
-        bool HasTangents() const { return !Tangents.empty(); }
+        // Return the attributes, regardless of whether they are owned by the mesh or shared with other meshes
+        const std::vector<glm::vec3>& GetVertices() const { return SharedVertices ? *SharedVertices : Vertices; }
+        const std::vector<glm::vec3>& GetVertexColours() const { return SharedVertexColours ? *SharedVertexColours : VertexColours; }
+        const std::vector<glm::vec3>& GetNormals() const { return SharedNormals ? *SharedNormals : Normals; }
+        const std::vector<glm::vec2>& GetTexCoords(size_t set) const { return SharedTexCoords.at(set) ? *SharedTexCoords[set] : TexCoords.at(set); }
+        const std::vector<glm::vec4>& GetTangents() const { return SharedTangents ? *SharedTangents : Tangents; }
+        
+        bool HasVertexColours() const { return !GetVertexColours().empty(); }
+        bool HasNormals() const { return !GetNormals().empty() || !QuantizedNormals.IsEmpty(); }
+        bool HasTangents() const { return !GetTangents().empty() || !QuantizedTangents.IsEmpty(); }
+        bool HasQuantizedVertices() const { return !QuantizedVertices.IsEmpty(); }
     };
 
     /*! @brief A model is a collection of multiple meshes, that belong together. When rendered, models should appear as one single
@@ -81,6 +168,10 @@ namespace OCASI {
         std::string Name;
 
         std::vector<Mesh> Meshes;
+
+        //! @brief Loads the vertex and index data of all meshes (see Mesh::LoadGeometry()).
+        void LoadGeometry();
+        bool IsGeometryLoaded() const;
     };
 
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "PostProcessor.h"
 
+#include "OCASI/Core/Scene.h"
+
 #include "OCASI/PostProcessing/ConverToRHCProcess.h"
 #include "OCASI/PostProcessing/TriangulateProcess.h"
 #include "OCASI/PostProcessing/GenerateNormalsProcess.h"
@@ -30,15 +32,35 @@ namespace OCASI {
         if (m_Processes == PostProcessorOptions::None)
             return;
         
+        std::vector<BasePostProcess*> deferredProcesses;
         for (auto& process : s_PostProcessingProcesses)
         {
             if (m_Processes & process->GetProcessType())
             {
+                // Processes, that don't apply to the importer, are neither executed now nor once a mesh is loaded
+                if (!process->SupportsImporter(*m_Importer))
+                    continue;
+                deferredProcesses.push_back(process.get());
+                
                 if(!process->NeedsProcessing(m_Scene, m_Importer))
                     continue;
                 
                 process->ExecuteProcess();
             }
         }
+        
+        // Meshes without geometry are skipped by the processes and processed once their geometry is loaded
+        GeometrySource* lastSource = nullptr;
+        for (auto& model : m_Scene->Models)
+        {
+            for (auto& mesh : model.Meshes)
+            {
+                if (!mesh.Geometry || mesh.Geometry.get() == lastSource)
+                    continue;
+                
+                mesh.Geometry->SetDeferredPostProcesses(deferredProcesses);
+                lastSource = mesh.Geometry.get();
+            }
+        }
     }
 }
\ No newline at end of file
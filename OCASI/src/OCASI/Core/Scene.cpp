@@ -0,0 +1,136 @@
+#include "Scene.h"
+
+#include "OCASI/Core/ThreadPool.h"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <unordered_set>
+
+namespace OCASI {
+
+    namespace {
+
+        bool LoadImage(const SharedPtr<Image>& image, bool flipVertically, const Scene::ImageLoadedCallback& onImageLoaded)
+        {
+            bool loaded = false;
+            try
+            {
+                loaded = image->Load(flipVertically) != nullptr;
+            }
+            catch (const std::exception& e)
+            {
+                // Decoding errors are reported like any other image, that failed to decode
+                OCASI_LOG_ERROR(FORMAT("Failed to decode image: {}", e.what()));
+            }
+
+            if (!loaded)
+                OCASI_LOG_WARN(FORMAT("Failed to decode image '{}'.", image->IsMemoryImage() ? "<embedded>" : image->GetImagePath().string()));
+
+            if (onImageLoaded)
+                onImageLoaded(image, loaded);
+            return loaded;
+        }
+
+        std::vector<SharedPtr<Image>> GetImagesToLoad(Scene& scene)
+        {
+            std::vector<SharedPtr<Image>> images = scene.GetImages();
+            std::erase_if(images, [](const SharedPtr<Image>& image) { return image->IsLoaded(); });
+            return images;
+        }
+
+    }
+
+    std::vector<SharedPtr<Image>> Scene::GetImages()
+    {
+        std::vector<SharedPtr<Image>> images;
+        std::unordered_set<Image*> visited;
+        for (auto& material : Materials)
+        {
+            for (size_t i = 0; i < MATERIAL_TEXTURE_ARRAY_SIZE; i++)
+            {
+                if (!material.HasTexture(i))
+                    continue;
+
+                SharedPtr<Image> image = material.GetTexture(i);
+                if (visited.insert(image.get()).second)
+                    images.push_back(std::move(image));
+            }
+        }
+        return images;
+    }
+
+    bool Scene::LoadImages(bool flipVertically, const ImageLoadedCallback& onImageLoaded)
+    {
+        std::vector<SharedPtr<Image>> images = GetImagesToLoad(*this);
+
+        std::atomic<bool> allLoaded = true;
+        ThreadPool::GetGlobal().ParallelFor(images.size(), [&](size_t i)
+        {
+            if (!LoadImage(images[i], flipVertically, onImageLoaded))
+                allLoaded = false;
+        });
+        return allLoaded;
+    }
+
+    std::future<bool> Scene::LoadImagesAsync(bool flipVertically, ImageLoadedCallback onImageLoaded)
+    {
+        struct AsyncLoadState
+        {
+            std::vector<SharedPtr<Image>> Images;
+            ImageLoadedCallback OnImageLoaded;
+            bool FlipVertically = true;
+
+            std::atomic<size_t> RemainingCount = 0;
+            std::atomic<bool> AllLoaded = true;
+            std::exception_ptr Error;
+            std::mutex ErrorMutex;
+            std::promise<bool> Promise;
+        };
+
+        auto state = MakeShared<AsyncLoadState>();
+        state->Images = GetImagesToLoad(*this);
+        state->OnImageLoaded = std::move(onImageLoaded);
+        state->FlipVertically = flipVertically;
+        state->RemainingCount = state->Images.size();
+
+        std::future<bool> future = state->Promise.get_future();
+        if (state->Images.empty())
+        {
+            state->Promise.set_value(true);
+            return future;
+        }
+
+        // One task per image, so a few large textures do not end up on the same worker
+        ThreadPool& pool = ThreadPool::GetGlobal();
+        for (size_t i = 0; i < state->Images.size(); i++)
+        {
+            pool.Submit([state, i]()
+            {
+                try
+                {
+                    if (!LoadImage(state->Images[i], state->FlipVertically, state->OnImageLoaded))
+                        state->AllLoaded = false;
+                }
+                catch (...)
+                {
+                    // Exceptions of the callback must not escape the task, they are passed on through the future instead
+                    std::lock_guard lock(state->ErrorMutex);
+                    if (!state->Error)
+                        state->Error = std::current_exception();
+                }
+
+                if (--state->RemainingCount != 0)
+                    return;
+
+                std::lock_guard lock(state->ErrorMutex);
+                if (state->Error)
+                    state->Promise.set_exception(state->Error);
+                else
+                    state->Promise.set_value(state->AllLoaded);
+            });
+        }
+        return future;
+    }
+
+}
@@ -3,6 +3,9 @@
 #include "OCASI/Core/Model.h"
 #include "OCASI/Core/Material.h"
 
+#include <functional>
+#include <future>
+
 namespace OCASI {
 
     /*! @brief A geometry node holding a parent and a collection of children, along with an optional model index and a transform of that
@@ -47,6 +50,32 @@ namespace OCASI {
      */
     struct Scene
     {
+        //! Called for every image that was decoded by LoadImages() or LoadImagesAsync(), along with whether decoding succeeded.
+        using ImageLoadedCallback = std::function<void(const SharedPtr<Image>& image, bool loaded)>;
+
+        //! @brief Returns every image referenced by the materials once, even if multiple materials or textures share it.
+        std::vector<SharedPtr<Image>> GetImages();
+
+        /*! @brief Decodes all images, that are not loaded yet, in parallel on the global thread pool and returns when they are done.
+         *
+         *  @param flipVertically Passed to Image::Load().
+         *  @param onImageLoaded Optional, called from the thread that decoded the image. If it throws, the exception is
+         *                       rethrown once all images are done.
+         *  @return Whether all images could be decoded.
+         */
+        bool LoadImages(bool flipVertically = true, const ImageLoadedCallback& onImageLoaded = {});
+        /*! @brief Queues the images, that are not loaded yet, for decoding on the global thread pool and returns immediately.
+         *
+         *  The images are kept alive until they are decoded, so the scene may be destroyed in the meantime. The images must not
+         *  be read before the returned future is ready. If the global pool has a thread count of 1, the images are decoded
+         *  before this function returns.
+         *  @param flipVertically Passed to Image::Load().
+         *  @param onImageLoaded Optional, called from the thread that decoded the image. If it throws, the first exception
+         *                       is stored in the future instead of a result.
+         *  @return A future, that is set to whether all images could be decoded, once the last one is done.
+         */
+        std::future<bool> LoadImagesAsync(bool flipVertically = true, ImageLoadedCallback onImageLoaded = {});
+
         std::vector<Model> Models;
         std::vector<Material> Materials;
         std::vector<SharedPtr<Node>> RootNodes;
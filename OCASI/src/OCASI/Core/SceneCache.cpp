@@ -0,0 +1,509 @@
+#include "SceneCache.h"
+
+#include "OCASI/Core/FileUtil.h"
+
+#include <fstream>
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+
+namespace OCASI {
+
+    // Has to be increased, whenever the layout of the cache file changes
+    constexpr uint32_t SCENE_CACHE_FORMAT_VERSION = 2;
+    constexpr char SCENE_CACHE_MAGIC[8] = { 'O', 'C', 'A', 'S', 'I', 'S', 'C', 0 };
+    constexpr size_t SCENE_CACHE_ARRAY_ALIGNMENT = 16;
+    constexpr uint64_t INVALID_CACHE_INDEX = UINT64_MAX;
+
+    struct SceneCacheHeader
+    {
+        char Magic[8];
+        uint32_t FormatVersion;
+        uint32_t ImporterType;
+        uint32_t ImporterVersion;
+        uint32_t Options;
+        uint32_t KeepQuantizedVertexData;
+        uint64_t ContentHash;
+    };
+
+    namespace {
+
+        class CacheWriter
+        {
+        public:
+            template<typename T>
+            void Write(const T& value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                Append(&value, sizeof(T));
+            }
+
+            //! Writes the element count, followed by the elements at the next aligned offset.
+            template<typename T>
+            void WriteArray(const std::vector<T>& array)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                Write<uint64_t>(array.size());
+                m_Data.resize((m_Data.size() + SCENE_CACHE_ARRAY_ALIGNMENT - 1) / SCENE_CACHE_ARRAY_ALIGNMENT * SCENE_CACHE_ARRAY_ALIGNMENT);
+                Append(array.data(), array.size() * sizeof(T));
+            }
+
+            void WriteString(const std::string& string)
+            {
+                Write<uint64_t>(string.size());
+                Append(string.data(), string.size());
+            }
+
+            const std::vector<uint8_t>& GetData() const { return m_Data; }
+
+        private:
+            void Append(const void* data, size_t size)
+            {
+                const uint8_t* bytes = static_cast<const uint8_t*>(data);
+                m_Data.insert(m_Data.end(), bytes, bytes + size);
+            }
+        private:
+            std::vector<uint8_t> m_Data;
+        };
+
+        //! Reads from the mapped cache file. Reading past its end throws a FailedImportError.
+        class CacheReader
+        {
+        public:
+            CacheReader(std::span<const uint8_t> data)
+                : m_Data(data)
+            {}
+
+            template<typename T>
+            T Read()
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                T value;
+                std::memcpy(&value, Get(sizeof(T)), sizeof(T));
+                return value;
+            }
+
+            template<typename T>
+            void ReadArray(std::vector<T>& outArray)
+            {
+                uint64_t count = Read<uint64_t>();
+                m_Pointer = (m_Pointer + SCENE_CACHE_ARRAY_ALIGNMENT - 1) / SCENE_CACHE_ARRAY_ALIGNMENT * SCENE_CACHE_ARRAY_ALIGNMENT;
+                if (count > (m_Data.size() - std::min(m_Pointer, m_Data.size())) / sizeof(T))
+                    throw FailedImportError("Array exceeds the end of the file.");
+
+                outArray.resize(count);
+                if (count != 0)
+                    std::memcpy(outArray.data(), Get(count * sizeof(T)), count * sizeof(T));
+            }
+
+            std::string ReadString()
+            {
+                uint64_t size = Read<uint64_t>();
+                if (size > m_Data.size())
+                    throw FailedImportError("String exceeds the end of the file.");
+
+                return std::string(reinterpret_cast<const char*>(Get(size)), size);
+            }
+
+        private:
+            const uint8_t* Get(size_t size)
+            {
+                if (m_Pointer > m_Data.size() || size > m_Data.size() - m_Pointer)
+                    throw FailedImportError("Unexpected end of file.");
+
+                const uint8_t* data = m_Data.data() + m_Pointer;
+                m_Pointer += size;
+                return data;
+            }
+        private:
+            std::span<const uint8_t> m_Data;
+            size_t m_Pointer = 0;
+        };
+
+        uint64_t HashFile(const Path& path)
+        {
+            MappedFile file(path);
+            return file.IsOpen() ? SceneCache::HashData(file.GetSpan()) : 0;
+        }
+
+        void WriteImage(CacheWriter& writer, Image& image, bool storeDecodedTextures)
+        {
+            if (storeDecodedTextures && !image.IsLoaded() && !image.Load())
+                OCASI_LOG_WARN(FORMAT("Could not decode {} for the scene cache, the image is cached undecoded.", image.GetImagePath().string()));
+
+            const ImageSettings& settings = image.GetImageSettings();
+            const ImageData& data = image.GetImageData();
+
+            writer.Write<uint8_t>(image.IsMemoryImage());
+            writer.Write<uint8_t>(image.IsLoaded());
+            writer.Write<uint32_t>((uint32_t) settings.MinFilter);
+            writer.Write<uint32_t>((uint32_t) settings.MagFilter);
+            writer.Write<uint32_t>((uint32_t) settings.Clamp);
+            writer.Write<uint32_t>((uint32_t) settings.Orientation);
+            writer.WriteString(image.GetImagePath().string());
+            writer.Write<uint32_t>(data.Width);
+            writer.Write<uint32_t>(data.Height);
+            writer.Write<uint8_t>(data.Channels);
+            writer.WriteArray(data.Data);
+        }
+
+        SharedPtr<Image> ReadImage(CacheReader& reader)
+        {
+            bool memoryImage = reader.Read<uint8_t>();
+            bool loaded = reader.Read<uint8_t>();
+
+            ImageSettings settings = {};
+            settings.MinFilter = (FilterOption) reader.Read<uint32_t>();
+            settings.MagFilter = (FilterOption) reader.Read<uint32_t>();
+            settings.Clamp = (ClampOption) reader.Read<uint32_t>();
+            settings.Orientation = (TextureOrientation) reader.Read<uint32_t>();
+            Path path = reader.ReadString();
+
+            uint32_t width = reader.Read<uint32_t>();
+            uint32_t height = reader.Read<uint32_t>();
+            uint8_t channels = reader.Read<uint8_t>();
+            std::vector<uint8_t> data;
+            reader.ReadArray(data);
+
+            if (loaded)
+                return MakeShared<Image>(std::move(data), channels, width, height, settings);
+            if (memoryImage)
+                return MakeShared<Image>(std::move(data), settings);
+            return MakeShared<Image>(path, settings);
+        }
+
+        void WriteQuantizedAttribute(CacheWriter& writer, const QuantizedAttribute& attribute)
+        {
+            writer.Write<uint32_t>((uint32_t) attribute.Type);
+            writer.Write<uint32_t>(attribute.ComponentCount);
+            writer.Write(attribute.Scale);
+            writer.Write(attribute.Offset);
+            writer.WriteArray(attribute.Data);
+        }
+
+        void ReadQuantizedAttribute(CacheReader& reader, QuantizedAttribute& outAttribute)
+        {
+            outAttribute.Type = (QuantizedComponentType) reader.Read<uint32_t>();
+            outAttribute.ComponentCount = reader.Read<uint32_t>();
+            outAttribute.Scale = reader.Read<glm::vec4>();
+            outAttribute.Offset = reader.Read<glm::vec4>();
+            reader.ReadArray(outAttribute.Data);
+        }
+
+        void WriteMesh(CacheWriter& writer, const Mesh& mesh)
+        {
+            writer.WriteString(mesh.Name);
+            writer.Write<uint64_t>(mesh.MaterialIndex == INVALID_ID ? INVALID_CACHE_INDEX : mesh.MaterialIndex);
+            writer.Write<uint32_t>((uint32_t) mesh.FaceMode);
+            writer.Write<uint32_t>((uint32_t) mesh.Dim);
+
+            // Shared attributes are written into every mesh and read back as owned ones
+            writer.WriteArray(mesh.GetVertices());
+            writer.WriteArray(mesh.GetVertexColours());
+            writer.WriteArray(mesh.GetNormals());
+            for (size_t i = 0; i < TEXTURE_COORDINATE_ARRAY_SIZE; i++)
+                writer.WriteArray(mesh.GetTexCoords(i));
+            writer.WriteArray(mesh.GetTangents());
+            writer.WriteArray(mesh.Indices);
+
+            WriteQuantizedAttribute(writer, mesh.QuantizedVertices);
+            WriteQuantizedAttribute(writer, mesh.QuantizedNormals);
+            for (const auto& texCoords : mesh.QuantizedTexCoords)
+                WriteQuantizedAttribute(writer, texCoords);
+            WriteQuantizedAttribute(writer, mesh.QuantizedTangents);
+        }
+
+        void ReadMesh(CacheReader& reader, Mesh& outMesh)
+        {
+            outMesh.Name = reader.ReadString();
+            uint64_t materialIndex = reader.Read<uint64_t>();
+            outMesh.MaterialIndex = materialIndex == INVALID_CACHE_INDEX ? INVALID_ID : (size_t) materialIndex;
+            outMesh.FaceMode = (FaceType) reader.Read<uint32_t>();
+            outMesh.Dim = (Dimension) reader.Read<uint32_t>();
+
+            reader.ReadArray(outMesh.Vertices);
+            reader.ReadArray(outMesh.VertexColours);
+            reader.ReadArray(outMesh.Normals);
+            for (auto& texCoords : outMesh.TexCoords)
+                reader.ReadArray(texCoords);
+            reader.ReadArray(outMesh.Tangents);
+            reader.ReadArray(outMesh.Indices);
+
+            ReadQuantizedAttribute(reader, outMesh.QuantizedVertices);
+            ReadQuantizedAttribute(reader, outMesh.QuantizedNormals);
+            for (auto& texCoords : outMesh.QuantizedTexCoords)
+                ReadQuantizedAttribute(reader, texCoords);
+            ReadQuantizedAttribute(reader, outMesh.QuantizedTangents);
+        }
+
+        //! Stores the nodes in depth first order, with every node referencing its parent by the index into that order.
+        void FlattenNodes(const SharedPtr<Node>& node, uint64_t parent, std::vector<std::pair<const Node*, uint64_t>>& outNodes)
+        {
+            uint64_t index = outNodes.size();
+            outNodes.emplace_back(node.get(), parent);
+
+            for (const auto& child : node->Children)
+                FlattenNodes(child, index, outNodes);
+        }
+    }
+
+    SharedPtr<Scene> SceneCache::Read(const Path& cachePath, const SceneCacheKey& key)
+    {
+        std::error_code error;
+        if (!std::filesystem::exists(cachePath, error))
+            return nullptr;
+
+        MappedFile file(cachePath);
+        if (!file.IsOpen())
+            return nullptr;
+
+        try
+        {
+            CacheReader reader(file.GetSpan());
+
+            auto header = reader.Read<SceneCacheHeader>();
+            SceneCacheKey cachedKey = { header.ContentHash, header.ImporterType, header.ImporterVersion, (PostProcessorOptions) header.Options,
+                                         header.KeepQuantizedVertexData != 0 };
+            if (std::memcmp(header.Magic, SCENE_CACHE_MAGIC, sizeof(SCENE_CACHE_MAGIC)) != 0 || header.FormatVersion != SCENE_CACHE_FORMAT_VERSION ||
+                cachedKey != key)
+                return nullptr;
+
+            uint64_t dependencyCount = reader.Read<uint64_t>();
+            for (uint64_t i = 0; i < dependencyCount; i++)
+            {
+                Path dependency = reader.ReadString();
+                if (reader.Read<uint64_t>() != HashFile(dependency))
+                    return nullptr;
+            }
+
+            auto scene = MakeShared<Scene>();
+
+            std::vector<SharedPtr<Image>> images(reader.Read<uint64_t>());
+            for (auto& image : images)
+                image = ReadImage(reader);
+
+            scene->Materials.resize(reader.Read<uint64_t>());
+            for (Material& material : scene->Materials)
+            {
+                material.SetName(reader.ReadString());
+
+                for (size_t i = 0; i < GetMaterialValueObjectSizesArraySize(); i++)
+                {
+                    uint8_t value[sizeof(glm::vec4)];
+                    for (size_t j = 0; j < MATERIAL_VALUE_OBJECT_SIZES[i]; j++)
+                        value[j] = reader.Read<uint8_t>();
+                    material.Set(value, i, MATERIAL_VALUE_OBJECT_SIZES[i]);
+                }
+
+                for (size_t i = 0; i < MATERIAL_TEXTURE_ARRAY_SIZE; i++)
+                {
+                    uint64_t imageIndex = reader.Read<uint64_t>();
+                    if (imageIndex == INVALID_CACHE_INDEX)
+                        continue;
+                    if (imageIndex >= images.size())
+                        throw FailedImportError("Invalid image index.");
+                    material.SetTexture(i, images.at(imageIndex));
+                }
+            }
+
+            scene->Models.resize(reader.Read<uint64_t>());
+            for (Model& model : scene->Models)
+            {
+                model.Name = reader.ReadString();
+                model.Meshes.resize(reader.Read<uint64_t>());
+                for (Mesh& mesh : model.Meshes)
+                    ReadMesh(reader, mesh);
+            }
+
+            std::vector<SharedPtr<Node>> nodes(reader.Read<uint64_t>());
+            for (size_t i = 0; i < nodes.size(); i++)
+            {
+                auto& node = nodes.at(i);
+                node = MakeShared<Node>();
+
+                uint64_t parent = reader.Read<uint64_t>();
+                uint64_t modelIndex = reader.Read<uint64_t>();
+                node->ModelIndex = modelIndex == INVALID_CACHE_INDEX ? INVALID_ID : (size_t) modelIndex;
+                node->LocalTransform = reader.Read<glm::mat4>();
+
+                if (parent == INVALID_CACHE_INDEX)
+                {
+                    scene->RootNodes.push_back(node);
+                    continue;
+                }
+
+                // Parents are always stored before their children
+                if (parent >= i)
+                    throw FailedImportError("Invalid parent node index.");
+                node->Parent = nodes.at(parent);
+                nodes.at(parent)->Children.push_back(node);
+            }
+
+            return scene;
+        }
+        catch (const FailedImportError& e)
+        {
+            OCASI_LOG_WARN(FORMAT("Ignoring corrupt scene cache file {}: {}", cachePath.string(), e.what()));
+            return nullptr;
+        }
+    }
+
+    bool SceneCache::Write(const Path& cachePath, Scene& scene, const SceneCacheKey& key, const std::vector<Path>& dependencies,
+                           bool storeDecodedTextures)
+    {
+        CacheWriter writer;
+
+        SceneCacheHeader header = {};
+        std::memcpy(header.Magic, SCENE_CACHE_MAGIC, sizeof(SCENE_CACHE_MAGIC));
+        header.FormatVersion = SCENE_CACHE_FORMAT_VERSION;
+        header.ImporterType = key.ImporterType;
+        header.ImporterVersion = key.ImporterVersion;
+        header.Options = (uint32_t) key.Options;
+        header.KeepQuantizedVertexData = key.KeepQuantizedVertexData ? 1 : 0;
+        header.ContentHash = key.ContentHash;
+        writer.Write(header);
+
+        writer.Write<uint64_t>(dependencies.size());
+        for (const Path& dependency : dependencies)
+        {
+            writer.WriteString(dependency.string());
+            writer.Write<uint64_t>(HashFile(dependency));
+        }
+
+        // Images may be shared by multiple materials, so they are stored once and referenced by their index
+        std::vector<Image*> images;
+        std::unordered_map<const Image*, uint64_t> imageIndices;
+        for (Material& material : scene.Materials)
+        {
+            for (size_t i = 0; i < MATERIAL_TEXTURE_ARRAY_SIZE; i++)
+            {
+                auto image = material.GetTexture(i);
+                if (image && imageIndices.try_emplace(image.get(), images.size()).second)
+                    images.push_back(image.get());
+            }
+        }
+
+        writer.Write<uint64_t>(images.size());
+        for (Image* image : images)
+            WriteImage(writer, *image, storeDecodedTextures);
+
+        writer.Write<uint64_t>(scene.Materials.size());
+        for (Material& material : scene.Materials)
+        {
+            writer.WriteString(material.GetName());
+
+            for (size_t i = 0; i < GetMaterialValueObjectSizesArraySize(); i++)
+            {
+                const uint8_t* value = static_cast<const uint8_t*>(material.Get(i));
+                for (size_t j = 0; j < MATERIAL_VALUE_OBJECT_SIZES[i]; j++)
+                    writer.Write<uint8_t>(value[j]);
+            }
+
+            for (size_t i = 0; i < MATERIAL_TEXTURE_ARRAY_SIZE; i++)
+            {
+                auto image = material.GetTexture(i);
+                writer.Write<uint64_t>(image ? imageIndices.at(image.get()) : INVALID_CACHE_INDEX);
+            }
+        }
+
+        writer.Write<uint64_t>(scene.Models.size());
+        for (const Model& model : scene.Models)
+        {
+            writer.WriteString(model.Name);
+            writer.Write<uint64_t>(model.Meshes.size());
+            for (const Mesh& mesh : model.Meshes)
+                WriteMesh(writer, mesh);
+        }
+
+        std::vector<std::pair<const Node*, uint64_t>> nodes;
+        for (const auto& root : scene.RootNodes)
+            FlattenNodes(root, INVALID_CACHE_INDEX, nodes);
+
+        writer.Write<uint64_t>(nodes.size());
+        for (const auto& [node, parent] : nodes)
+        {
+            writer.Write<uint64_t>(parent);
+            writer.Write<uint64_t>(node->ModelIndex == INVALID_ID ? INVALID_CACHE_INDEX : node->ModelIndex);
+            writer.Write(node->LocalTransform);
+        }
+
+        // The file is written under a temporary name first, so that a concurrent reader never sees a partial file
+        std::error_code error;
+        std::filesystem::create_directories(cachePath.parent_path(), error);
+
+        Path temporaryPath = cachePath;
+        temporaryPath += ".tmp";
+        {
+            std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!stream.is_open())
+                return false;
+
+            const auto& data = writer.GetData();
+            stream.write(reinterpret_cast<const char*>(data.data()), (std::streamsize) data.size());
+            if (!stream)
+                return false;
+        }
+
+        std::filesystem::rename(temporaryPath, cachePath, error);
+        return !error;
+    }
+
+    uint64_t SceneCache::HashData(std::span<const uint8_t> data)
+    {
+        // Four independent lanes keep the multiplications from waiting on each other, the structure follows xxHash64
+        constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ull;
+        constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4Full;
+        auto round = [](uint64_t lane, uint64_t value)
+        {
+            lane += value * PRIME_2;
+            lane = (lane << 31) | (lane >> 33);
+            return lane * PRIME_1;
+        };
+
+        uint64_t lanes[4] = { PRIME_1 + PRIME_2, PRIME_2, 0, 0 - PRIME_1 };
+        const uint8_t* pointer = data.data();
+        size_t remaining = data.size();
+
+        while (remaining >= 32)
+        {
+            for (uint64_t& lane : lanes)
+            {
+                uint64_t value;
+                std::memcpy(&value, pointer, sizeof(value));
+                lane = round(lane, value);
+                pointer += sizeof(value);
+            }
+            remaining -= 32;
+        }
+
+        uint64_t hash = data.size();
+        for (uint64_t lane : lanes)
+            hash = round(hash ^ lane, lane);
+
+        while (remaining > 0)
+        {
+            hash = round(hash, *pointer++);
+            remaining--;
+        }
+
+        hash ^= hash >> 33;
+        hash *= PRIME_2;
+        hash ^= hash >> 29;
+        hash *= PRIME_1;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+    Path SceneCache::GetCachePath(const Path& cacheDirectory, const Path& filePath)
+    {
+        std::error_code error;
+        Path absolutePath = std::filesystem::weakly_canonical(filePath, error);
+        if (error)
+            absolutePath = filePath;
+
+        std::string pathString = absolutePath.string();
+        uint64_t pathHash = HashData({ reinterpret_cast<const uint8_t*>(pathString.data()), pathString.size() });
+        return cacheDirectory / FORMAT("{:016x}.ocasi", pathHash);
+    }
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "OCASI/Core/Scene.h"
+#include "OCASI/Core/PostProcessorOptions.h"
+
+#include <span>
+
+namespace OCASI {
+
+    //! @brief Everything a cached scene depends on. A cache entry is only used, if all of it matches.
+    struct SceneCacheKey
+    {
+        //! The hash of the imported file's content.
+        uint64_t ContentHash = 0;
+        uint32_t ImporterType = 0;
+        uint32_t ImporterVersion = 0;
+        //! The post processing operations, that were applied to the cached scene.
+        PostProcessorOptions Options = PostProcessorOptions::None;
+        //! Whether quantized vertex data was kept while importing the cached scene.
+        bool KeepQuantizedVertexData = false;
+
+        bool operator==(const SceneCacheKey& other) const = default;
+    };
+
+    /*! @brief Stores imported scenes in a flat binary file, that is memory mapped when it is read back.
+     *
+     *  Every vertex, index and image array is stored 16 byte aligned in the same layout as inside the scene, so it is
+     *  copied out of the mapping with a single memcpy. Besides the key, the cache file records the content hashes of all
+     *  files referenced by the imported file (.mtl and .bin files), so changing one of them invalidates the cache entry
+     *  as well. Cache files are only meant to be read on the machine, that wrote them.
+     */
+    class SceneCache
+    {
+    public:
+        /*! @brief Reads a scene from a cache file.
+         *
+         *  @return The cached scene or nullptr, if the file does not exist, was written for a different key or is corrupt.
+         */
+        static SharedPtr<Scene> Read(const Path& cachePath, const SceneCacheKey& key);
+        /*! @brief Writes a scene into a cache file, replacing the previous entry.
+         *
+         *  @param dependencies The files, that were opened while importing the scene.
+         *  @param storeDecodedTextures Decodes all textures of the scene and stores the pixels, instead of the image paths.
+         *  @return Whether the cache file could be written.
+         */
+        static bool Write(const Path& cachePath, Scene& scene, const SceneCacheKey& key, const std::vector<Path>& dependencies,
+                          bool storeDecodedTextures);
+
+        //! @brief Hashes file data for the SceneCacheKey.
+        static uint64_t HashData(std::span<const uint8_t> data);
+        //! @brief Returns the path of the cache file for the imported file inside the cache directory.
+        static Path GetCachePath(const Path& cacheDirectory, const Path& filePath);
+    };
+
+}
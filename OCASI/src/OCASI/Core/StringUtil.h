@@ -100,7 +100,6 @@ namespace OCASI::Util {
     std::vector<std::string> Split(const std::string& target, char token);
     std::vector<std::string> Split(const std::string& target, char token, uint32_t& outTokenCount);
 
-    uint8_t* DecodeBase64(const std::string& dataString, size_t& outSize);
     std::string URIUnescapedString(const std::string& input);
     bool StartsWith(const std::string& s, const std::string& prefix);
 }
\ No newline at end of file
@@ -0,0 +1,287 @@
+#include "TextScanner.h"
+
+#include <bit>
+#include <algorithm>
+#include <charconv>
+
+// The instruction set is selected at compile time. SSE2 is part of every x86-64 target and NEON of every AArch64
+// target, AVX2 is only used if the compiler is allowed to emit it (OCASI_ENABLE_AVX2).
+#if defined(__AVX2__)
+    #define OCASI_SCANNER_AVX2
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define OCASI_SCANNER_SSE2
+    #include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define OCASI_SCANNER_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace OCASI::Util {
+
+    namespace {
+
+        constexpr size_t BLOCK_SIZE = 64;
+
+        bool IsSeparator(char c)
+        {
+            return c == ' ' || c == '\t';
+        }
+
+#if defined(OCASI_SCANNER_AVX2)
+
+        constexpr size_t VECTOR_WIDTH = 32;
+
+        uint64_t EqualMask(const char* data, char c)
+        {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+            return (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(c)));
+        }
+
+        uint64_t SeparatorMask(const char* data)
+        {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+            __m256i separators = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\t')));
+            return (uint32_t) _mm256_movemask_epi8(separators);
+        }
+
+#elif defined(OCASI_SCANNER_SSE2)
+
+        constexpr size_t VECTOR_WIDTH = 16;
+
+        uint64_t EqualMask(const char* data, char c)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(c)));
+        }
+
+        uint64_t SeparatorMask(const char* data)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            __m128i separators = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t')));
+            return (uint32_t) _mm_movemask_epi8(separators);
+        }
+
+#elif defined(OCASI_SCANNER_NEON)
+
+        constexpr size_t VECTOR_WIDTH = 16;
+
+        // NEON has no movemask instruction, so every lane gets its own bit and the halves are summed horizontally
+        uint64_t MoveMask(uint8x16_t comparison)
+        {
+            static const uint8_t bits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+            uint8x16_t masked = vandq_u8(comparison, vld1q_u8(bits));
+            return (uint64_t) vaddv_u8(vget_low_u8(masked)) | ((uint64_t) vaddv_u8(vget_high_u8(masked)) << 8);
+        }
+
+        uint64_t EqualMask(const char* data, char c)
+        {
+            uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(data));
+            return MoveMask(vceqq_u8(chunk, vdupq_n_u8((uint8_t) c)));
+        }
+
+        uint64_t SeparatorMask(const char* data)
+        {
+            uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(data));
+            return MoveMask(vorrq_u8(vceqq_u8(chunk, vdupq_n_u8(' ')), vceqq_u8(chunk, vdupq_n_u8('\t'))));
+        }
+
+#else
+
+        // Without vector instructions a machine word is processed at a time
+        constexpr size_t VECTOR_WIDTH = 8;
+
+        uint64_t EqualMask(const char* data, char c)
+        {
+            uint64_t mask = 0;
+            for (size_t i = 0; i < VECTOR_WIDTH; i++)
+                mask |= (uint64_t) (data[i] == c) << i;
+            return mask;
+        }
+
+        uint64_t SeparatorMask(const char* data)
+        {
+            uint64_t mask = 0;
+            for (size_t i = 0; i < VECTOR_WIDTH; i++)
+                mask |= (uint64_t) IsSeparator(data[i]) << i;
+            return mask;
+        }
+
+#endif
+
+        constexpr uint64_t VECTOR_BITS = VECTOR_WIDTH == 64 ? ~0ull : (1ull << VECTOR_WIDTH) - 1;
+
+        // Builds the line feed mask for up to 64 bytes. Only full vectors are loaded, so nothing is read past the end.
+        uint64_t LineFeedMask(const char* data, size_t size)
+        {
+            uint64_t mask = 0;
+            size_t i = 0;
+            for (; i + VECTOR_WIDTH <= size; i += VECTOR_WIDTH)
+                mask |= EqualMask(data + i, '\n') << i;
+            for (; i < size; i++)
+                mask |= (uint64_t) (data[i] == '\n') << i;
+            return mask;
+        }
+    }
+
+    const char* GetTextScannerInstructionSet()
+    {
+#if defined(OCASI_SCANNER_AVX2)
+        return "AVX2";
+#elif defined(OCASI_SCANNER_SSE2)
+        return "SSE2";
+#elif defined(OCASI_SCANNER_NEON)
+        return "NEON";
+#else
+        return "Scalar";
+#endif
+    }
+
+    const char* FindChar(const char* begin, const char* end, char c)
+    {
+        for (; begin + VECTOR_WIDTH <= end; begin += VECTOR_WIDTH)
+        {
+            if (uint64_t mask = EqualMask(begin, c))
+                return begin + std::countr_zero(mask);
+        }
+
+        while (begin != end && *begin != c)
+            begin++;
+        return begin;
+    }
+
+    const char* FindSeparator(const char* begin, const char* end)
+    {
+        for (; begin + VECTOR_WIDTH <= end; begin += VECTOR_WIDTH)
+        {
+            if (uint64_t mask = SeparatorMask(begin))
+                return begin + std::countr_zero(mask);
+        }
+
+        while (begin != end && !IsSeparator(*begin))
+            begin++;
+        return begin;
+    }
+
+    const char* SkipSeparators(const char* begin, const char* end)
+    {
+        // Tokens are usually separated by a single character, so a vector load would not pay off
+        while (begin != end && IsSeparator(*begin))
+            begin++;
+        return begin;
+    }
+
+    uint32_t CountTokens(const char* begin, const char* end)
+    {
+        uint32_t tokenCount = 0;
+        // Whether the character before the current vector belongs to a token
+        uint64_t previousInToken = 0;
+
+        for (; begin + VECTOR_WIDTH <= end; begin += VECTOR_WIDTH)
+        {
+            uint64_t inToken = ~SeparatorMask(begin) & VECTOR_BITS;
+            // A token starts at every character, that is part of a token while its predecessor is not
+            uint64_t tokenStarts = inToken & ~((inToken << 1) | previousInToken);
+            tokenCount += std::popcount(tokenStarts);
+            previousInToken = (inToken >> (VECTOR_WIDTH - 1)) & 1;
+        }
+
+        for (; begin != end; begin++)
+        {
+            uint64_t inToken = !IsSeparator(*begin);
+            tokenCount += inToken & ~previousInToken;
+            previousInToken = inToken;
+        }
+
+        return tokenCount;
+    }
+
+    std::string_view NextToken(const char*& begin, const char* end)
+    {
+        const char* tokenBegin = SkipSeparators(begin, end);
+        begin = FindSeparator(tokenBegin, end);
+        return { tokenBegin, (size_t) (begin - tokenBegin) };
+    }
+
+    float ParseFloat(std::string_view token)
+    {
+        const char* begin = token.data();
+        const char* end = token.data() + token.size();
+
+        // from_chars does not accept a leading plus sign
+        if (begin != end && *begin == '+')
+        {
+            begin++;
+            if (begin != end && *begin == '-')
+                throw FailedImportError(FORMAT("Cannot parse '{}' as a number", token));
+        }
+
+        float value = 0.0f;
+        auto [ptr, error] = std::from_chars(begin, end, value);
+
+        if (error == std::errc::result_out_of_range)
+            throw FailedImportError(FORMAT("Number {} is out of the range of a float", token));
+        if (error != std::errc() || ptr != end || begin == end)
+            throw FailedImportError(FORMAT("Cannot parse '{}' as a number", token));
+
+        return value;
+    }
+
+    float NextFloat(const char*& begin, const char* end)
+    {
+        return ParseFloat(NextToken(begin, end));
+    }
+
+    LineScanner::LineScanner(std::string_view data)
+        : m_Data(data.data()), m_Size(data.size())
+    {
+        LoadNextBlock();
+    }
+
+    bool LineScanner::NextLine(std::string_view& outLine)
+    {
+        if (m_LineStart >= m_Size)
+            return false;
+
+        while (m_BlockMask == 0)
+        {
+            m_BlockOffset += BLOCK_SIZE;
+
+            // The last line is not terminated by a line feed
+            if (m_BlockOffset >= m_Size)
+            {
+                outLine = { m_Data + m_LineStart, m_Size - m_LineStart };
+                m_LineStart = m_Size;
+
+                if (outLine.ends_with('\r'))
+                    outLine.remove_suffix(1);
+                return true;
+            }
+
+            LoadNextBlock();
+        }
+
+        size_t lineEnd = m_BlockOffset + std::countr_zero(m_BlockMask);
+        // Clears the lowest set bit
+        m_BlockMask &= m_BlockMask - 1;
+
+        outLine = { m_Data + m_LineStart, lineEnd - m_LineStart };
+        m_LineStart = lineEnd + 1;
+
+        if (outLine.ends_with('\r'))
+            outLine.remove_suffix(1);
+        return true;
+    }
+
+    void LineScanner::LoadNextBlock()
+    {
+        if (m_BlockOffset >= m_Size)
+        {
+            m_BlockMask = 0;
+            return;
+        }
+
+        m_BlockMask = LineFeedMask(m_Data + m_BlockOffset, std::min(BLOCK_SIZE, m_Size - m_BlockOffset));
+    }
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "OCASI/Core/Base.h"
+
+#include <string_view>
+
+namespace OCASI::Util {
+
+    //! @brief Returns the name of the vector instruction set, that the text scanning functions were compiled for.
+    const char* GetTextScannerInstructionSet();
+
+    /*! @brief Finds the first occurrence of a character in [begin, end).
+     *
+     *  @return A pointer to the found character or end, if the character is not present.
+     */
+    const char* FindChar(const char* begin, const char* end, char c);
+
+    /*! @brief Finds the first space or tab character in [begin, end).
+     *
+     *  @return A pointer to the found separator or end, if there is no separator.
+     */
+    const char* FindSeparator(const char* begin, const char* end);
+
+    //! @brief Returns a pointer to the first character in [begin, end), that is not a space or a tab.
+    const char* SkipSeparators(const char* begin, const char* end);
+
+    //! @brief Counts the tokens in [begin, end), that are separated by one or more spaces or tabs.
+    uint32_t CountTokens(const char* begin, const char* end);
+
+    /*! @brief Returns the next token, that is separated by spaces or tabs, as a view into [begin, end).
+     *
+     *  Leading separators are skipped, begin is moved to the character after the token.
+     *  @return The token or an empty view, if there are no tokens left.
+     */
+    std::string_view NextToken(const char*& begin, const char* end);
+
+    /*! @brief Parses a float from a token without allocating and independent of the current locale.
+     *
+     *  Accepts decimal and exponent notation with an optional leading sign, as well as inf and nan.
+     *  @throws FailedImportError If the token is empty, not a number, or contains trailing characters.
+     */
+    float ParseFloat(std::string_view token);
+
+    //! @brief Parses the next token as a float and moves begin behind it. See ParseFloat() and NextToken().
+    float NextFloat(const char*& begin, const char* end);
+
+    /*! @brief Splits a contiguous buffer into lines.
+     *
+     *  The buffer is scanned 64 bytes at a time and the line feed positions of a block are kept as a bit mask, so most
+     *  lines are found without touching the data again. Lines are returned as views into the buffer without the line
+     *  feed and a trailing carriage return.
+     */
+    class LineScanner
+    {
+    public:
+        LineScanner(std::string_view data);
+
+        //! @brief Returns the next line. Returns false, if the end of the buffer has been reached.
+        bool NextLine(std::string_view& outLine);
+
+        //! @brief The offset of the first character, that has not been returned as part of a line yet.
+        size_t GetOffset() const { return m_LineStart; }
+
+    private:
+        void LoadNextBlock();
+    private:
+        const char* m_Data = nullptr;
+        size_t m_Size = 0;
+
+        size_t m_BlockOffset = 0;
+        uint64_t m_BlockMask = 0;
+        size_t m_LineStart = 0;
+    };
+
+}
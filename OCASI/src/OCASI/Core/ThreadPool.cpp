@@ -0,0 +1,145 @@
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <algorithm>
+#include <exception>
+
+namespace OCASI {
+
+    UniquePtr<ThreadPool> ThreadPool::s_GlobalPool = nullptr;
+    uint32_t ThreadPool::s_GlobalThreadCount = 0;
+    std::mutex ThreadPool::s_GlobalMutex;
+
+    ThreadPool::ThreadPool(uint32_t threadCount)
+        : m_ThreadCount(std::max(threadCount, 1u))
+    {
+        m_Workers.reserve(m_ThreadCount - 1);
+        for (uint32_t i = 1; i < m_ThreadCount; i++)
+            m_Workers.emplace_back([this]() { WorkerLoop(); });
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock(m_TaskMutex);
+            m_Stop = true;
+        }
+        m_TaskAvailable.notify_all();
+
+        for (auto& worker : m_Workers)
+            worker.join();
+    }
+
+    void ThreadPool::Submit(std::function<void()> task)
+    {
+        if (m_Workers.empty())
+        {
+            task();
+            return;
+        }
+
+        {
+            std::lock_guard lock(m_TaskMutex);
+            m_Tasks.push(std::move(task));
+        }
+        m_TaskAvailable.notify_one();
+    }
+
+    void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& function)
+    {
+        if (count == 0)
+            return;
+
+        struct ParallelForState
+        {
+            std::atomic<size_t> NextIndex = 0;
+            std::atomic<size_t> FinishedCount = 0;
+            std::vector<std::exception_ptr> Errors;
+
+            std::mutex Mutex;
+            std::condition_variable Finished;
+        };
+
+        auto state = MakeShared<ParallelForState>();
+        state->Errors.resize(count);
+
+        // Helpers, that start after all indices have been handed out, return without touching the function
+        auto run = [state, &function, count]()
+        {
+            for (size_t i = state->NextIndex++; i < count; i = state->NextIndex++)
+            {
+                try
+                {
+                    function(i);
+                }
+                catch (...)
+                {
+                    state->Errors[i] = std::current_exception();
+                }
+
+                if (++state->FinishedCount == count)
+                {
+                    std::lock_guard lock(state->Mutex);
+                    state->Finished.notify_all();
+                }
+            }
+        };
+
+        size_t helperCount = std::min(count - 1, m_Workers.size());
+        for (size_t i = 0; i < helperCount; i++)
+            Submit(run);
+
+        // The calling thread works as well, which also keeps nested calls from waiting on queued tasks
+        run();
+
+        {
+            std::unique_lock lock(state->Mutex);
+            state->Finished.wait(lock, [&state, count]() { return state->FinishedCount == count; });
+        }
+
+        for (auto& error : state->Errors)
+        {
+            if (error)
+                std::rethrow_exception(error);
+        }
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(m_TaskMutex);
+                m_TaskAvailable.wait(lock, [this]() { return m_Stop || !m_Tasks.empty(); });
+
+                if (m_Stop && m_Tasks.empty())
+                    return;
+
+                task = std::move(m_Tasks.front());
+                m_Tasks.pop();
+            }
+            task();
+        }
+    }
+
+    ThreadPool& ThreadPool::GetGlobal()
+    {
+        std::lock_guard lock(s_GlobalMutex);
+        if (!s_GlobalPool)
+        {
+            uint32_t threadCount = s_GlobalThreadCount ? s_GlobalThreadCount : std::thread::hardware_concurrency();
+            s_GlobalPool = MakeUnique<ThreadPool>(threadCount);
+        }
+        return *s_GlobalPool;
+    }
+
+    void ThreadPool::SetGlobalThreadCount(uint32_t threadCount)
+    {
+        std::lock_guard lock(s_GlobalMutex);
+        s_GlobalThreadCount = threadCount;
+        // The pool is recreated with the new thread count on its next use
+        s_GlobalPool = nullptr;
+    }
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "OCASI/Core/Base.h"
+
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+
+namespace OCASI {
+
+    /*! @brief A fixed size pool of worker threads, that is shared by the importers.
+     *
+     *  The thread calling ParallelFor() takes part in the work, so a pool with a thread count of n owns n - 1 worker
+     *  threads. A thread count of 1 runs everything on the calling thread.
+     */
+    class ThreadPool
+    {
+    public:
+        ThreadPool(uint32_t threadCount);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        //! @brief Queues a task, that is executed by one of the worker threads, or directly if there are no workers.
+        void Submit(std::function<void()> task);
+
+        /*! @brief Calls function(i) for every i in [0, count) in parallel and returns when all calls have finished.
+         *
+         *  Calls are handed out in ascending order. It is safe to call ParallelFor() from inside a task of the same pool.
+         *  @throws The exception thrown by the call with the lowest index, after all calls have finished.
+         */
+        void ParallelFor(size_t count, const std::function<void(size_t)>& function);
+
+        uint32_t GetThreadCount() const { return m_ThreadCount; }
+
+        //! @brief Returns the pool used by all importers. It is created on first use.
+        static ThreadPool& GetGlobal();
+        /*! @brief Sets the thread count of the global pool. Must not be called while a file is being imported.
+         *
+         *  @param threadCount The number of threads, including the calling thread. 0 uses the hardware concurrency.
+         */
+        static void SetGlobalThreadCount(uint32_t threadCount);
+
+    private:
+        void WorkerLoop();
+    private:
+        uint32_t m_ThreadCount = 1;
+        std::vector<std::thread> m_Workers;
+
+        std::queue<std::function<void()>> m_Tasks;
+        std::mutex m_TaskMutex;
+        std::condition_variable m_TaskAvailable;
+        bool m_Stop = false;
+
+        static UniquePtr<ThreadPool> s_GlobalPool;
+        static uint32_t s_GlobalThreadCount;
+        static std::mutex s_GlobalMutex;
+    };
+
+}
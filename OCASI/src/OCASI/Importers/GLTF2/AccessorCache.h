@@ -0,0 +1,128 @@
+#pragma once
+
+#include "OCASI/Core/Model.h"
+
+#include "glm/glm.hpp"
+
+#include <mutex>
+#include <unordered_map>
+#include <variant>
+
+namespace OCASI::GLTF {
+
+    //! @brief What an accessor is read as. An accessor, that is read as different attributes, is cached once per usage.
+    enum class AccessorUsage : uint8_t
+    {
+        Indices = 0,
+        Position,
+        Normal,
+        Tangent,
+        TexCoord,
+        Colour
+    };
+
+    /*! @brief Decodes accessors, that are referenced by multiple primitives, only once per import.
+     *
+     *  Exporters often let many primitives share the same vertex attribute accessors and only give them different index
+     *  accessors. All references have to be registered with AddReference() first, afterwards Read() may be called from
+     *  multiple threads at the same time, once per registered reference. Accessors with a single reference are decoded
+     *  straight into the output. Shared ones are decoded into the cache by their first reader and copied out of it, until
+     *  the last reader takes the decoded data, which frees the entry again. If the cache shares decoded data, ReadShared()
+     *  hands the same array to all readers of an accessor instead of copying it.
+     */
+    class AccessorCache
+    {
+    public:
+        AccessorCache(bool shareDecodedData = false)
+            : m_ShareDecodedData(shareDecodedData)
+        {}
+
+        void AddReference(size_t accessorIndex, AccessorUsage usage)
+        {
+            m_Entries[GetKey(accessorIndex, usage)].References++;
+        }
+
+        /*! @brief Writes the decoded accessor into out.
+         *
+         *  @param decode Decodes the accessor into the T, that it is passed. Called once for shared accessors, unless it
+         *                throws.
+         */
+        template<typename T, typename Decoder>
+        void Read(size_t accessorIndex, AccessorUsage usage, T& out, Decoder&& decode)
+        {
+            auto it = m_Entries.find(GetKey(accessorIndex, usage));
+            if (it == m_Entries.end() || it->second.References < 2)
+            {
+                decode(out);
+                return;
+            }
+
+            // Readers of the same accessor wait for each other, different accessors are read in parallel
+            Entry& entry = it->second;
+            std::lock_guard lock(entry.Mutex);
+            if (std::holds_alternative<std::monostate>(entry.Data))
+            {
+                T data;
+                decode(data);
+                entry.Data = std::move(data);
+            }
+
+            if (++entry.Reads == entry.References)
+            {
+                out = std::move(std::get<T>(entry.Data));
+                entry.Data = std::monostate();
+            }
+            else
+            {
+                out = std::get<T>(entry.Data);
+            }
+        }
+
+        /*! @brief Points outShared to the decoded accessor, if it is shared and the cache shares decoded data, otherwise
+         *         behaves like Read() and writes it into out.
+         */
+        template<typename T, typename Decoder>
+        void ReadShared(size_t accessorIndex, AccessorUsage usage, std::vector<T>& out, SharedPtr<std::vector<T>>& outShared, Decoder&& decode)
+        {
+            auto it = m_Entries.find(GetKey(accessorIndex, usage));
+            if (!m_ShareDecodedData || it == m_Entries.end() || it->second.References < 2)
+            {
+                Read(accessorIndex, usage, out, std::forward<Decoder>(decode));
+                return;
+            }
+
+            Entry& entry = it->second;
+            std::lock_guard lock(entry.Mutex);
+            if (!entry.SharedData)
+            {
+                auto data = MakeShared<std::vector<T>>();
+                decode(*data);
+                entry.SharedData = data;
+            }
+
+            outShared = std::static_pointer_cast<std::vector<T>>(entry.SharedData);
+            // The meshes own the data from now on
+            if (++entry.Reads == entry.References)
+                entry.SharedData = nullptr;
+        }
+    private:
+        using CachedData = std::variant<std::monostate, std::vector<uint32_t>, std::vector<glm::vec2>, std::vector<glm::vec3>,
+                                        std::vector<glm::vec4>, QuantizedAttribute>;
+
+        struct Entry
+        {
+            size_t References = 0;
+            size_t Reads = 0;
+            std::mutex Mutex;
+            CachedData Data;
+            SharedPtr<void> SharedData;
+        };
+
+        static uint64_t GetKey(size_t accessorIndex, AccessorUsage usage) { return ((uint64_t) accessorIndex << 3) | (uint64_t) usage; }
+    private:
+        // Entries are only added before the primitives are read, so the map is never modified while it is read
+        std::unordered_map<uint64_t, Entry> m_Entries;
+        bool m_ShareDecodedData = false;
+    };
+
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "OCASI/Importers/GLTF2/AccessorView.h"
+#include "OCASI/Core/Model.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/type_ptr.hpp"
+
+#include <array>
+#include <limits>
+#include <type_traits>
+
+namespace OCASI::GLTF {
+
+    // Normalized integers are mapped to [0, 1] (unsigned) or [-1, 1] (signed), as defined by the glTF specification
+    template<typename Component, bool Normalized>
+    inline float ConvertComponent(Component component)
+    {
+        if constexpr (!Normalized || std::is_floating_point_v<Component>)
+            return (float) component;
+        else if constexpr (std::is_signed_v<Component>)
+            return std::max((float) component / (float) std::numeric_limits<Component>::max(), -1.0f);
+        else
+            return (float) component / (float) std::numeric_limits<Component>::max();
+    }
+
+    // The loop only depends on the component type, which lets the compiler vectorize it
+    template<typename Component, bool Normalized>
+    void ConvertComponents(const uint8_t* data, size_t componentCount, float* out)
+    {
+        for (size_t i = 0; i < componentCount; i++)
+        {
+            Component component;
+            std::memcpy(&component, data + i * sizeof(Component), sizeof(Component));
+            out[i] = ConvertComponent<Component, Normalized>(component);
+        }
+    }
+
+    /*! @brief Converts every element of an accessor with ComponentCount components of type Component into a float vector.
+     *
+     *  Components, that the accessor does not have, are set to 0 and superfluous components are dropped. The kernel is
+     *  instantiated for every combination, so the inner loop does not branch on the component type.
+     */
+    template<typename Component, size_t ComponentCount, bool Normalized, glm::length_t OutCount>
+    void ConvertAccessor(const Asset& asset, size_t accessorIndex, std::vector<glm::vec<OutCount, float>>& out)
+    {
+        using OutElement = glm::vec<OutCount, float>;
+
+        // Float vectors of the same size are copied as they are
+        if constexpr (std::is_same_v<Component, float> && ComponentCount == OutCount)
+        {
+            AccessorView<OutElement> view(asset, accessorIndex);
+            out.resize(view.GetSize());
+            view.CopyTo(out.data());
+        }
+        else
+        {
+            using Element = std::array<Component, ComponentCount>;
+            constexpr size_t CONVERTED_COUNT = std::min<size_t>(ComponentCount, OutCount);
+
+            AccessorView<Element> view(asset, accessorIndex);
+            out.resize(view.GetSize());
+
+            auto convert = [](const Element& element)
+            {
+                OutElement result(0.0f);
+                for (size_t i = 0; i < CONVERTED_COUNT; i++)
+                    result[i] = ConvertComponent<Component, Normalized>(element[i]);
+                return result;
+            };
+
+            // Packed elements, that keep their component count, are converted as one flat array of components
+            if constexpr (ComponentCount == OutCount)
+            {
+                if (const uint8_t* data = view.GetPackedData())
+                {
+                    ConvertComponents<Component, Normalized>(data, view.GetSize() * ComponentCount, glm::value_ptr(out[0]));
+                    if (view.IsSparse())
+                        view.ApplySparseValues(out.data(), convert);
+                    return;
+                }
+            }
+
+            view.ConvertTo(out.data(), convert);
+        }
+    }
+
+    template<typename Component, size_t ComponentCount, glm::length_t OutCount>
+    void ConvertAccessor(const Asset& asset, size_t accessorIndex, bool normalized, std::vector<glm::vec<OutCount, float>>& out)
+    {
+        if (normalized)
+            ConvertAccessor<Component, ComponentCount, true>(asset, accessorIndex, out);
+        else
+            ConvertAccessor<Component, ComponentCount, false>(asset, accessorIndex, out);
+    }
+
+    inline const Accessor& GetAccessor(const Asset& asset, size_t accessorIndex, size_t componentCount)
+    {
+        const Accessor& accessor = asset.Accessors.at(accessorIndex);
+        if ((size_t) accessor.Type != componentCount)
+            throw FailedImportError(FORMAT("Accessor {} has {} components, but {} components were expected.", accessorIndex, (size_t) accessor.Type, componentCount));
+        return accessor;
+    }
+
+    /*! @brief Reads an accessor with ComponentCount components of any component type into float vectors.
+     *
+     *  The kernel is selected once per accessor by its component type and normalized flag.
+     *  @throws FailedImportError If the accessor does not have ComponentCount components or uses an unsigned int type.
+     */
+    template<size_t ComponentCount, glm::length_t OutCount>
+    void ReadFloatAccessor(const Asset& asset, size_t accessorIndex, std::vector<glm::vec<OutCount, float>>& out)
+    {
+        const Accessor& accessor = GetAccessor(asset, accessorIndex, ComponentCount);
+        switch (accessor.CompType)
+        {
+            case ComponentType::Float:
+                ConvertAccessor<float, ComponentCount, false>(asset, accessorIndex, out);
+                break;
+            case ComponentType::Byte:
+                ConvertAccessor<int8_t, ComponentCount>(asset, accessorIndex, accessor.Normalized, out);
+                break;
+            case ComponentType::UnsignedByte:
+                ConvertAccessor<uint8_t, ComponentCount>(asset, accessorIndex, accessor.Normalized, out);
+                break;
+            case ComponentType::Short:
+                ConvertAccessor<int16_t, ComponentCount>(asset, accessorIndex, accessor.Normalized, out);
+                break;
+            case ComponentType::UnsignedShort:
+                ConvertAccessor<uint16_t, ComponentCount>(asset, accessorIndex, accessor.Normalized, out);
+                break;
+            default:
+                throw FailedImportError(FORMAT("Unsupported component type {} used for vertex attribute accessor {}.", (int) accessor.CompType, accessorIndex));
+        }
+    }
+
+    // The integers are copied as they are, normalized integers get the scale, that maps them to [0, 1] or [-1, 1]
+    template<typename Component, size_t ComponentCount>
+    void CopyQuantizedAccessor(const Asset& asset, size_t accessorIndex, QuantizedComponentType type, QuantizedAttribute& out)
+    {
+        using Element = std::array<Component, ComponentCount>;
+
+        AccessorView<Element> view(asset, accessorIndex);
+        out.Type = type;
+        out.ComponentCount = ComponentCount;
+        out.Data.resize(view.GetSize() * sizeof(Element));
+        view.CopyTo(reinterpret_cast<Element*>(out.Data.data()));
+
+        float scale = asset.Accessors[accessorIndex].Normalized ? 1.0f / (float) std::numeric_limits<Component>::max() : 1.0f;
+        out.Scale = glm::vec4(1.0f);
+        out.Offset = glm::vec4(0.0f);
+        for (size_t i = 0; i < ComponentCount; i++)
+            out.Scale[i] = scale;
+    }
+
+    /*! @brief Keeps an integer accessor with ComponentCount components in its quantized form.
+     *
+     *  @throws FailedImportError If the accessor does not have ComponentCount components or does not use a byte or
+     *          short component type.
+     */
+    template<size_t ComponentCount>
+    void ReadQuantizedAccessor(const Asset& asset, size_t accessorIndex, QuantizedAttribute& out)
+    {
+        const Accessor& accessor = GetAccessor(asset, accessorIndex, ComponentCount);
+        switch (accessor.CompType)
+        {
+            case ComponentType::Byte:
+                CopyQuantizedAccessor<int8_t, ComponentCount>(asset, accessorIndex, QuantizedComponentType::Int8, out);
+                break;
+            case ComponentType::UnsignedByte:
+                CopyQuantizedAccessor<uint8_t, ComponentCount>(asset, accessorIndex, QuantizedComponentType::UInt8, out);
+                break;
+            case ComponentType::Short:
+                CopyQuantizedAccessor<int16_t, ComponentCount>(asset, accessorIndex, QuantizedComponentType::Int16, out);
+                break;
+            case ComponentType::UnsignedShort:
+                CopyQuantizedAccessor<uint16_t, ComponentCount>(asset, accessorIndex, QuantizedComponentType::UInt16, out);
+                break;
+            default:
+                throw FailedImportError(FORMAT("Unsupported component type {} used for quantized accessor {}.", (int) accessor.CompType, accessorIndex));
+        }
+    }
+
+    //! @brief Reads an index accessor of any unsigned component type into 32 bit indices.
+    template<typename Index>
+    void ReadWidenedIndices(const Asset& asset, size_t accessorIndex, std::vector<uint32_t>& out)
+    {
+        AccessorView<Index> view(asset, accessorIndex);
+        out.resize(view.GetSize());
+
+        if constexpr (std::is_same_v<Index, uint32_t>)
+            view.CopyTo(out.data());
+        else
+            view.ConvertTo(out.data(), [](Index index) { return (uint32_t) index; });
+    }
+
+}
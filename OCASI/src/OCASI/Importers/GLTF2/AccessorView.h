@@ -0,0 +1,179 @@
+#pragma once
+
+#include "OCASI/Importers/GLTF2/Asset.h"
+
+#include <cstring>
+
+namespace OCASI::GLTF {
+
+    /*! @brief A typed view of the elements of an accessor, which reads them directly from their buffer.
+     *
+     *  The byte stride of the buffer view and the byte offsets of the buffer view and the accessor are applied while
+     *  reading, so the buffer data is never copied into an intermediate vector. T has to have the byte size of one
+     *  accessor element (e.g. glm::vec3 for a float VEC3 accessor), otherwise the constructor throws a FailedImportError.
+     *  Sparse values are only applied by CopyTo() and ConvertTo().
+     */
+    template<typename T>
+    class AccessorView
+    {
+    public:
+        AccessorView(const Asset& asset, size_t accessorIndex)
+            : m_Asset(asset)
+        {
+            if (accessorIndex >= asset.Accessors.size())
+                throw FailedImportError(FORMAT("Accessor index {} is out of range.", accessorIndex));
+            m_Accessor = &asset.Accessors[accessorIndex];
+            m_Count = m_Accessor->ElementCount;
+
+            size_t elementSize = ComponentTypeToBytes(m_Accessor->CompType) * (size_t) m_Accessor->Type;
+            if (elementSize != sizeof(T))
+                throw FailedImportError(FORMAT("Accessor {} has elements with a size of {} bytes, but {} bytes were expected.", accessorIndex, elementSize, sizeof(T)));
+
+            // The elements are written into arrays of GetSize() elements, whose byte size must not overflow
+            if (m_Count > SIZE_MAX / sizeof(T))
+                throw FailedImportError(FORMAT("Accessor {} has too many elements.", accessorIndex));
+
+            // Accessors without a buffer view are initialized with zeros
+            if (m_Accessor->BufferView == INVALID_ID || m_Count == 0)
+                return;
+
+            if (m_Accessor->BufferView >= asset.BufferViews.size())
+                throw FailedImportError(FORMAT("Buffer view index {} of accessor {} is out of range.", m_Accessor->BufferView, accessorIndex));
+            const BufferView& bufferView = asset.BufferViews[m_Accessor->BufferView];
+
+            // The byte stride is the distance between the starts of two elements, 0 means the elements are tightly packed
+            m_Stride = bufferView.ByteStride != 0 ? bufferView.ByteStride : sizeof(T);
+
+            // Checked by subtraction and division, so large values from the file cannot wrap around. This also keeps
+            // the element count within what the buffer view holds, before any output is allocated.
+            if (m_Accessor->ByteOffset > bufferView.ByteLength || bufferView.ByteLength - m_Accessor->ByteOffset < sizeof(T) ||
+                m_Count - 1 > (bufferView.ByteLength - m_Accessor->ByteOffset - sizeof(T)) / m_Stride)
+                throw FailedImportError(FORMAT("Accessor {} reads outside of its buffer view.", accessorIndex));
+
+            size_t byteLength = (m_Count - 1) * m_Stride + sizeof(T);
+            m_Data = GetBufferData(asset, bufferView, m_Accessor->ByteOffset, byteLength).data();
+        }
+
+        size_t GetSize() const { return m_Count; }
+        bool IsSparse() const { return m_Accessor->SparseAccessor.has_value(); }
+        //! @brief Returns the raw elements if they are tightly packed and stored in a buffer, nullptr otherwise.
+        const uint8_t* GetPackedData() const { return m_Stride == sizeof(T) ? m_Data : nullptr; }
+
+        //! @brief Returns the element without the sparse values applied.
+        T operator[](size_t index) const
+        {
+            T element = {};
+            if (m_Data)
+                std::memcpy(&element, m_Data + index * m_Stride, sizeof(T));
+            return element;
+        }
+
+        //! @brief Copies all elements into out, which has to hold GetSize() elements, and applies the sparse values.
+        void CopyTo(T* out) const
+        {
+            auto copy = [](const T& element) { return element; };
+            if (!m_Data || m_Stride != sizeof(T))
+            {
+                ConvertTo(out, copy);
+                return;
+            }
+
+            std::memcpy(out, m_Data, m_Count * sizeof(T));
+            if (IsSparse())
+                ApplySparseValues(out, copy);
+        }
+
+        /*! @brief Writes convert(element) into out for all elements, which has to hold GetSize() elements, and applies
+         *         the sparse values.
+         *
+         *  Tightly packed elements are read with a stride known at compile time, so the conversion loop can be vectorized.
+         */
+        template<typename Out, typename Converter>
+        void ConvertTo(Out* out, Converter&& convert) const
+        {
+            if (!m_Data)
+                std::fill(out, out + m_Count, convert(T{}));
+            else if (m_Stride == sizeof(T))
+                ConvertElements<sizeof(T)>(m_Data, sizeof(T), out, convert);
+            else
+                ConvertElements<0>(m_Data, m_Stride, out, convert);
+
+            if (IsSparse())
+                ApplySparseValues(out, convert);
+        }
+
+        //! @brief Overwrites the elements in out, that are replaced by sparse values, with their converted values.
+        template<typename Out, typename Converter>
+        void ApplySparseValues(Out* out, Converter& convert) const
+        {
+            const Sparse& sparse = m_Accessor->SparseAccessor.value();
+            if (sparse.ElementCount == 0)
+                return;
+
+            if (sparse.Indices.BufferView >= m_Asset.BufferViews.size() || sparse.Values.BufferView >= m_Asset.BufferViews.size())
+                throw FailedImportError("Buffer view index of a sparse accessor is out of range.");
+
+            const BufferView& indicesView = m_Asset.BufferViews[sparse.Indices.BufferView];
+            const BufferView& valuesView = m_Asset.BufferViews[sparse.Values.BufferView];
+
+            size_t indexSize = ComponentTypeToBytes(sparse.Indices.CompType);
+            if (indexSize != 1 && indexSize != 2 && indexSize != 4)
+                throw FailedImportError(FORMAT("Unsupported component type used for sparse accessor {}.", (int) sparse.Indices.CompType));
+
+            // Sparse indices and values are always tightly packed
+            if (sparse.ElementCount > indicesView.ByteLength / indexSize || sparse.ElementCount > valuesView.ByteLength / sizeof(T))
+                throw FailedImportError("A sparse accessor has more elements than its buffer views hold.");
+            const uint8_t* indices = GetBufferData(m_Asset, indicesView, sparse.Indices.ByteOffset, sparse.ElementCount * indexSize).data();
+            const uint8_t* values = GetBufferData(m_Asset, valuesView, sparse.Values.ByteOffset, sparse.ElementCount * sizeof(T)).data();
+
+            for (size_t i = 0; i < sparse.ElementCount; i++)
+            {
+                uint32_t index = 0;
+                std::memcpy(&index, indices + i * indexSize, indexSize);
+                if (index >= m_Count)
+                    throw FailedImportError(FORMAT("Sparse accessor index {} is out of range.", index));
+
+                T element;
+                std::memcpy(&element, values + i * sizeof(T), sizeof(T));
+                out[index] = convert(element);
+            }
+        }
+
+    private:
+        // A stride of 0 uses the runtime stride
+        template<size_t Stride, typename Out, typename Converter>
+        void ConvertElements(const uint8_t* data, size_t runtimeStride, Out* out, Converter& convert) const
+        {
+            size_t stride = Stride != 0 ? Stride : runtimeStride;
+            for (size_t i = 0; i < m_Count; i++)
+            {
+                T element;
+                std::memcpy(&element, data + i * stride, sizeof(T));
+                out[i] = convert(element);
+            }
+        }
+
+        //! @brief Returns byteLength bytes, that start at byteOffset inside the buffer view.
+        static std::span<const uint8_t> GetBufferData(const Asset& asset, const BufferView& bufferView, size_t byteOffset, size_t byteLength)
+        {
+            if (bufferView.Buffer >= asset.Buffers.size())
+                throw FailedImportError(FORMAT("Buffer index {} is out of range.", bufferView.Buffer));
+            if (byteOffset > bufferView.ByteLength || byteLength > bufferView.ByteLength - byteOffset)
+                throw FailedImportError(FORMAT("Cannot read data that lies outside of buffer view {}.", bufferView.GetIndex()));
+
+            // The buffer view lies inside the buffer, so the offset can no longer wrap around
+            const Buffer& buffer = asset.Buffers[bufferView.Buffer];
+            if (bufferView.ByteOffset > buffer.GetByteSize() || bufferView.ByteLength > buffer.GetByteSize() - bufferView.ByteOffset)
+                throw FailedImportError(FORMAT("Buffer view {} lies outside of its buffer.", bufferView.GetIndex()));
+            return buffer.GetView(byteLength, bufferView.ByteOffset + byteOffset);
+        }
+    private:
+        const Asset& m_Asset;
+        const Accessor* m_Accessor = nullptr;
+
+        const uint8_t* m_Data = nullptr;
+        size_t m_Stride = sizeof(T);
+        size_t m_Count = 0;
+    };
+
+}
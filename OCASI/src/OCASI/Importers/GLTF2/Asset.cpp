@@ -1,5 +1,6 @@
 #include "Asset.h"
 
+#include "OCASI/Core/Base64.h"
 #include "OCASI/Core/StringUtil.h"
 
 namespace OCASI::GLTF {
@@ -35,37 +36,67 @@ namespace OCASI::GLTF {
         }
 
         size_t fileSize = reader.GetFileSize();
-        m_Data = reader.GetFileDataInBytes();
-
         OCASI_ASSERT_MSG(fileSize == bufferSize, FORMAT("Specified byte size doe not match read byte size of glTF .bin file data. read size: {}, specified size: {}", fileSize, bufferSize));
+
+        // The importer advises the mapping, depending on whether the whole buffer or only some ranges are read
+        SetData(reader.GetFileSpan(), reader.GetMappedFile());
         m_ByteSize = fileSize;
     }
 
-    Buffer::Buffer(size_t id, const std::string& URIData, size_t bufferSize)
+    Buffer::Buffer(size_t id, std::string_view dataURI, size_t bufferSize)
         : Object(id)
     {
-        size_t readSize = 0;
-        m_Data = Util::DecodeBase64(URIData, readSize);
+        m_OwnedData = Util::DecodeBase64(Util::GetBase64DataURIPayload(dataURI));
+        size_t readSize = m_OwnedData.size();
 
         OCASI_ASSERT_MSG(readSize == bufferSize, FORMAT("Specified byte size doe not match read byte size of glTF uri base64 encoded data. read size: {}, specified size: {}", readSize, bufferSize));
         m_ByteSize = readSize;
     }
 
-    Buffer::~Buffer()
+    Buffer::Buffer(size_t id, std::vector<uint8_t>&& data)
+        : Object(id), m_OwnedData(std::move(data))
+    {
+        m_ByteSize = m_OwnedData.size();
+    }
+
+    void Buffer::SetData(std::span<const uint8_t> data, SharedPtr<MappedFile> source)
+    {
+        m_OwnedData.clear();
+        m_ExternalData = data;
+        m_Source = std::move(source);
+    }
+
+    void Buffer::Advise(MemoryAccessHint hint, size_t byteLength, size_t offset) const
     {
-        delete m_Data;
+        if (!m_Source || !m_OwnedData.empty() || offset >= m_ByteSize)
+            return;
+
+        // The buffer does not necessarily start at the beginning of the mapping, e.g. the binary chunk of a .glb file
+        size_t bufferOffset = (size_t) (m_ExternalData.data() - m_Source->GetSpan().data());
+        m_Source->Advise(hint, bufferOffset + offset, std::min(byteLength, m_ByteSize - offset));
     }
 
     std::vector<uint8_t> Buffer::Get(size_t byteLength, size_t offset)
     {
-        if (offset + byteLength > m_ByteSize)
+        if (offset > m_ByteSize || byteLength > m_ByteSize - offset)
             throw FailedImportError("Cannot read data that lies outside the buffers memory.");
         
         std::vector<uint8_t> result;
         result.resize(byteLength);
-        void* data = m_Data + offset;
-        std::memcpy(result.data(), data, byteLength);
+        std::memcpy(result.data(), GetData() + offset, byteLength);
 
         return result;
     }
+
+    std::span<const uint8_t> Buffer::GetView(size_t byteLength, size_t offset) const
+    {
+        if (offset > m_ByteSize || byteLength > m_ByteSize - offset)
+            throw FailedImportError("Cannot read data that lies outside the buffers memory.");
+        if (m_IsFallback)
+            throw FailedImportError(FORMAT("Buffer {} is a fallback buffer of EXT_meshopt_compression and has no data.", GetIndex()));
+        if (!HasData())
+            throw FailedImportError(FORMAT("Buffer {} has no data.", GetIndex()));
+
+        return { GetData() + offset, byteLength };
+    }
 }
@@ -33,7 +33,12 @@ namespace OCASI::GLTF {
                 "KHR_materials_transmission",
                 "KHR_materials_unlit",
                 "KHR_materials_variants",
-                "KHR_materials_volume"
+                "KHR_materials_volume",
+                "KHR_mesh_quantization",
+#if defined(OCASI_ENABLE_DRACO)
+                "KHR_draco_mesh_compression",
+#endif
+                "EXT_meshopt_compression"
     };
 
     // The values specify the glTF enum values as stated in the glTF 2.0 spec
@@ -44,7 +49,7 @@ namespace OCASI::GLTF {
         UnsignedByte = 5121,
         Short = 5122,
         UnsignedShort = 5123,
-        UnsignedInt = 5124,
+        UnsignedInt = 5125,
         Float = 5126
     };
 
@@ -116,6 +121,33 @@ namespace OCASI::GLTF {
         size_t m_Index;
     };
 
+    enum class MeshoptMode
+    {
+        Attributes = 0,
+        Triangles,
+        Indices
+    };
+
+    enum class MeshoptFilter
+    {
+        None = 0,
+        Octahedral,
+        Quaternion,
+        Exponential
+    };
+
+    // EXT_meshopt_compression: The bufferView is stored compressed in a range of another buffer
+    struct MeshoptCompression
+    {
+        size_t Buffer = INVALID_ID;
+        size_t ByteOffset = 0;
+        size_t ByteLength = INVALID_ID;
+        size_t ByteStride = INVALID_ID;
+        size_t Count = INVALID_ID;
+        MeshoptMode Mode = MeshoptMode::Attributes;
+        MeshoptFilter Filter = MeshoptFilter::None;
+    };
+
     struct BufferView : public Object
     {
         BufferView(size_t index)
@@ -127,6 +159,9 @@ namespace OCASI::GLTF {
         size_t ByteOffset = 0;
         size_t ByteStride = 0; // Although byteStride does not have a default value, it is easier than making it an optional. It's adding a 0 in an equation.
         // The bufferView.target property is not implemented as it's useless
+
+        // The importer decodes compressed bufferViews into buffers of their own, before any accessor is read
+        std::optional<MeshoptCompression> Meshopt;
     };
 
     struct Sparse
@@ -169,6 +204,14 @@ namespace OCASI::GLTF {
     using VertexAttributes = std::unordered_map<std::string, size_t>;
 
     // The primitive structs holds indices into the bufferView array
+    // KHR_draco_mesh_compression: The indices and the listed attributes are stored as a draco mesh inside a bufferView
+    struct KHRDracoMeshCompression
+    {
+        size_t BufferView = INVALID_ID;
+        // Maps the attribute names to the unique ids of the draco attributes
+        VertexAttributes Attributes;
+    };
+
     struct Primitive : public Object
     {
         Primitive(size_t index)
@@ -178,9 +221,11 @@ namespace OCASI::GLTF {
         PrimitiveType Type = PrimitiveType::Triangle;
         // Stores the accessors index using the string key in JSON
         VertexAttributes Attributes;
-        size_t MaterialIndex;
-        size_t Indices; // The accessor corresponding to the indices
+        size_t MaterialIndex = INVALID_ID;
+        size_t Indices = INVALID_ID; // The accessor corresponding to the indices
         std::vector<VertexAttributes> MorphTargets;
+
+        std::optional<KHRDracoMeshCompression> ExtDracoMeshCompression;
     };
 
     struct Mesh : public Object
@@ -357,18 +402,38 @@ namespace OCASI::GLTF {
     public:
 
         Buffer(size_t id, size_t bufferSize);
+        // References the mapped file data of the reader, without copying it
         Buffer(size_t id, FileReader& reader, size_t bufferSize);
-        Buffer(size_t id, const std::string& URIData, size_t bufferSize);
-        ~Buffer();
+        // Decodes the base64 payload of a data uri
+        Buffer(size_t id, std::string_view dataURI, size_t bufferSize);
+        // Takes ownership of data, that was decoded by the importer
+        Buffer(size_t id, std::vector<uint8_t>&& data);
 
         std::vector<uint8_t> Get(size_t byteLength, size_t offset);
+        // Returns a range of the buffer without copying it. The view is valid as long as the buffer is alive.
+        std::span<const uint8_t> GetView(size_t byteLength, size_t offset) const;
 
-        void SetData(uint8_t* data) { m_Data = data; }
+        // References external data. When the data lies inside a mapped file, the mapping is kept alive by the buffer.
+        void SetData(std::span<const uint8_t> data, SharedPtr<MappedFile> source = nullptr);
+        // Forwards an access hint for a range of the buffer to the mapped file, that the buffer references
+        void Advise(MemoryAccessHint hint, size_t byteLength = SIZE_MAX, size_t offset = 0) const;
 
+        bool HasData() const { return GetData() != nullptr; }
         size_t GetByteSize() const { return m_ByteSize; }
+
+        // Fallback buffers of EXT_meshopt_compression have no data, they only exist for loaders without the extension
+        void SetFallback(bool fallback) { m_IsFallback = fallback; }
+        bool IsFallback() const { return m_IsFallback; }
     private:
-        uint8_t* m_Data = nullptr;
+        const uint8_t* GetData() const { return m_OwnedData.empty() ? m_ExternalData.data() : m_OwnedData.data(); }
+    private:
+        // Either the buffer owns its data (decoded data uris), or it references a span inside a mapped file
+        std::vector<uint8_t> m_OwnedData;
+        std::span<const uint8_t> m_ExternalData;
+        SharedPtr<MappedFile> m_Source = nullptr;
+
         size_t m_ByteSize = 0;
+        bool m_IsFallback = false;
 
         friend class OCASI::GLTFImporter;
     };
@@ -438,7 +503,7 @@ namespace OCASI::GLTF {
         std::vector<Scene> Scenes;
         std::vector<std::string> ExtensionsUsed;
         std::vector<std::string> SupportedExtensionsUsed;
-        std::vector<std::string> ExtensionsRequired; // Always empty as I don't support any extensions, that are required
+        std::vector<std::string> ExtensionsRequired; // Only contains supported extensions, as other required extensions fail the import
 
         // TODO: Animations
     };
@@ -0,0 +1,125 @@
+#include "DracoDecoder.h"
+
+#include "OCASI/Core/StringUtil.h"
+
+#include "glm/gtc/type_ptr.hpp"
+
+#if defined(OCASI_ENABLE_DRACO)
+    #include "draco/compression/decode.h"
+    #include "draco/mesh/mesh.h"
+#endif
+
+namespace OCASI::GLTF {
+
+#if defined(OCASI_ENABLE_DRACO)
+
+    namespace {
+
+        // Converts a draco attribute into float vectors with ComponentCount components. Missing components are set to 0.
+        template<glm::length_t ComponentCount>
+        void ReadDracoAttribute(const draco::Mesh& dracoMesh, size_t uniqueId, std::vector<glm::vec<ComponentCount, float>>& out)
+        {
+            using Element = glm::vec<ComponentCount, float>;
+
+            const draco::PointAttribute* attribute = dracoMesh.GetAttributeByUniqueId((uint32_t) uniqueId);
+            if (!attribute)
+                throw FailedImportError(FORMAT("The draco mesh does not contain an attribute with the id {}.", uniqueId));
+
+            out.resize(dracoMesh.num_points());
+            if (out.empty())
+                return;
+
+            // Float attributes, that are stored once per point, already have the layout of the mesh array
+            if (attribute->is_mapping_identity() && attribute->data_type() == draco::DT_FLOAT32 &&
+                attribute->num_components() == ComponentCount && attribute->byte_stride() == sizeof(Element))
+            {
+                std::memcpy(glm::value_ptr(out[0]), attribute->GetAddress(draco::AttributeValueIndex(0)), out.size() * sizeof(Element));
+                return;
+            }
+
+            for (draco::PointIndex i(0); i < dracoMesh.num_points(); i++)
+            {
+                if (!attribute->ConvertValue<float>(attribute->mapped_index(i), (int8_t) ComponentCount, glm::value_ptr(out[i.value()])))
+                    throw FailedImportError(FORMAT("Failed to convert the draco attribute with the id {}.", uniqueId));
+            }
+        }
+
+    }
+
+    bool IsDracoSupported()
+    {
+        return true;
+    }
+
+    void DecodeDracoPrimitive(const Asset& asset, const KHRDracoMeshCompression& draco, OCASI::Mesh& outMesh)
+    {
+        const BufferView& bufferView = asset.BufferViews.at(draco.BufferView);
+        std::span<const uint8_t> data = asset.Buffers.at(bufferView.Buffer).GetView(bufferView.ByteLength, bufferView.ByteOffset);
+
+        // The decoder buffer only references the data
+        draco::DecoderBuffer buffer;
+        buffer.Init((const char*) data.data(), data.size());
+
+        draco::Decoder decoder;
+        auto result = decoder.DecodeMeshFromBuffer(&buffer);
+        if (!result.ok())
+            throw FailedImportError(FORMAT("Failed to decode draco mesh in bufferView {}: {}", draco.BufferView, result.status().error_msg_string()));
+        std::unique_ptr<draco::Mesh> dracoMesh = std::move(result).value();
+
+        // Strips are decoded into triangle lists
+        outMesh.FaceMode = FaceType::Triangle;
+        outMesh.Indices.resize((size_t) dracoMesh->num_faces() * 3);
+        for (draco::FaceIndex i(0); i < dracoMesh->num_faces(); i++)
+        {
+            const draco::Mesh::Face& face = dracoMesh->face(i);
+            outMesh.Indices[i.value() * 3 + 0] = face[0].value();
+            outMesh.Indices[i.value() * 3 + 1] = face[1].value();
+            outMesh.Indices[i.value() * 3 + 2] = face[2].value();
+        }
+
+        for (auto& [attributeName, uniqueId] : draco.Attributes)
+        {
+            if (attributeName == "POSITION")
+            {
+                ReadDracoAttribute(*dracoMesh, uniqueId, outMesh.Vertices);
+            }
+            else if (attributeName == "NORMAL")
+            {
+                ReadDracoAttribute(*dracoMesh, uniqueId, outMesh.Normals);
+            }
+            else if (attributeName == "TANGENT")
+            {
+                ReadDracoAttribute(*dracoMesh, uniqueId, outMesh.Tangents);
+            }
+            else if (Util::StartsWith(attributeName, "TEXCOORD_"))
+            {
+                const size_t TEX_COORD_STRING = 9;
+                size_t texCoordIndex = std::atoi(&attributeName.at(TEX_COORD_STRING));
+                if (texCoordIndex >= outMesh.TexCoords.size())
+                    continue;
+
+                ReadDracoAttribute(*dracoMesh, uniqueId, outMesh.TexCoords.at(texCoordIndex));
+            }
+            else if (attributeName == "COLOR_0")
+            {
+                // The alpha channel is dropped like for uncompressed colours
+                ReadDracoAttribute(*dracoMesh, uniqueId, outMesh.VertexColours);
+            }
+        }
+    }
+
+#else
+
+    bool IsDracoSupported()
+    {
+        return false;
+    }
+
+    void DecodeDracoPrimitive(const Asset&, const KHRDracoMeshCompression&, OCASI::Mesh&)
+    {
+        throw FailedImportError("The primitive is compressed with KHR_draco_mesh_compression, but OCASI was built without draco (OCASI_ENABLE_DRACO).");
+    }
+
+#endif
+
+}
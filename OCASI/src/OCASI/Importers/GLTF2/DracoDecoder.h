@@ -0,0 +1,21 @@
+#pragma once
+
+#include "OCASI/Core/Model.h"
+
+#include "OCASI/Importers/GLTF2/Asset.h"
+
+namespace OCASI::GLTF {
+
+    //! @brief Returns whether OCASI was built with draco (OCASI_ENABLE_DRACO).
+    bool IsDracoSupported();
+
+    /*! @brief Decodes the indices and the compressed attributes of a KHR_draco_mesh_compression primitive.
+     *
+     *  The attributes are converted from the decoded draco mesh straight into the arrays of outMesh. Attributes,
+     *  that are not part of the extension, are left untouched.
+     *  @throws FailedImportError If the draco data cannot be decoded, an attribute id does not exist, or OCASI was
+     *          built without draco.
+     */
+    void DecodeDracoPrimitive(const Asset& asset, const KHRDracoMeshCompression& draco, OCASI::Mesh& outMesh);
+
+}
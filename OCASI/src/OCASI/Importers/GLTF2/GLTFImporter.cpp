@@ -1,11 +1,20 @@
 #include "GLTFImporter.h"
 
 #include "OCASI/Core/BinaryReader.h"
+#include "OCASI/Core/Base64.h"
 #include "OCASI/Core/StringUtil.h"
+#include "OCASI/Core/ThreadPool.h"
 #include "Json.h"
 
 #include "glm/gtc/quaternion.hpp"
 
+#include "OCASI/Importers/GLTF2/AccessorCache.h"
+#include "OCASI/Importers/GLTF2/AccessorConversion.h"
+#include "OCASI/Importers/GLTF2/DracoDecoder.h"
+#include "OCASI/Importers/GLTF2/MeshoptDecoder.h"
+
+#include <map>
+
 using namespace simdjson;
 
 namespace OCASI {
@@ -17,6 +26,235 @@ namespace OCASI {
     const uint32_t CHUNK_TYPE_JSON = 0x4E4F534A;
     const uint32_t CHUNK_TYPE_BINARY = 0x004E4942;
 
+    bool GLTFImporter::s_KeepQuantizedVertexData = false;
+    bool GLTFImporter::s_LazyGeometryLoading = false;
+    bool GLTFImporter::s_ShareVertexData = false;
+
+    // Integer attributes are either expanded to floats or kept quantized, float attributes are always read as they are
+    template<size_t ComponentCount, glm::length_t OutCount>
+    static void ReadVertexAttribute(const GLTF::Asset& asset, size_t accessorIndex, GLTF::AccessorUsage usage, bool keepQuantized, GLTF::AccessorCache& cache,
+                                    std::vector<glm::vec<OutCount, float>>& outFloats, SharedPtr<std::vector<glm::vec<OutCount, float>>>& outSharedFloats,
+                                    QuantizedAttribute& outQuantized)
+    {
+        if (keepQuantized && asset.Accessors.at(accessorIndex).CompType != GLTF::ComponentType::Float)
+        {
+            cache.Read(accessorIndex, usage, outQuantized, [&](QuantizedAttribute& out) { GLTF::ReadQuantizedAccessor<ComponentCount>(asset, accessorIndex, out); });
+        }
+        else
+        {
+            cache.ReadShared(accessorIndex, usage, outFloats, outSharedFloats, [&](std::vector<glm::vec<OutCount, float>>& out)
+            {
+                GLTF::ReadFloatAccessor<ComponentCount>(asset, accessorIndex, out);
+            });
+        }
+    }
+
+    static void ReadIndices(const GLTF::Asset& asset, size_t accessorIndex, std::vector<uint32_t>& outIndices)
+    {
+        switch (asset.Accessors.at(accessorIndex).CompType)
+        {
+            case GLTF::ComponentType::UnsignedByte:
+            {
+                GLTF::ReadWidenedIndices<uint8_t>(asset, accessorIndex, outIndices);
+                break;
+            }
+            case GLTF::ComponentType::UnsignedShort:
+            {
+                GLTF::ReadWidenedIndices<uint16_t>(asset, accessorIndex, outIndices);
+                break;
+            }
+            case GLTF::ComponentType::UnsignedInt:
+            {
+                GLTF::ReadWidenedIndices<uint32_t>(asset, accessorIndex, outIndices);
+                break;
+            }
+            default:
+                throw FailedImportError(FORMAT("Unsupported component type {} used for indices.", (int) asset.Accessors.at(accessorIndex).CompType));
+        }
+    }
+
+    // Returns how the vertex attribute is converted into the mesh. Other attributes (e.g. skinning data) are ignored.
+    static std::optional<GLTF::AccessorUsage> GetAttributeUsage(const std::string& attributeName)
+    {
+        const size_t TEX_COORD_STRING = 9;
+        if (Util::StartsWith(attributeName, "TEXCOORD_"))
+        {
+            if ((size_t) std::atoi(&attributeName.at(TEX_COORD_STRING)) >= TEXTURE_COORDINATE_ARRAY_SIZE)
+                return std::nullopt;
+            return GLTF::AccessorUsage::TexCoord;
+        }
+
+        if (attributeName == "POSITION")
+            return GLTF::AccessorUsage::Position;
+        if (attributeName == "NORMAL")
+            return GLTF::AccessorUsage::Normal;
+        if (attributeName == "TANGENT")
+            return GLTF::AccessorUsage::Tangent;
+        if (attributeName == "COLOR_0")
+            return GLTF::AccessorUsage::Colour;
+        return std::nullopt;
+    }
+
+    // Calls read(accessorIndex, usage, set) for every accessor, that is read for the primitive. The set is the index of
+    // the texture coordinates, or 0 for other attributes.
+    template<typename Function>
+    static void ForEachReadAccessor(const GLTF::Primitive& primitive, Function&& read)
+    {
+        // Draco compressed indices and attributes are not read from their accessors
+        const auto& draco = primitive.ExtDracoMeshCompression;
+        bool decodeDraco = draco && GLTF::IsDracoSupported();
+
+        if (!decodeDraco && primitive.Indices != INVALID_ID)
+            read(primitive.Indices, GLTF::AccessorUsage::Indices, 0);
+
+        for (auto& [attributeName, accessor] : primitive.Attributes)
+        {
+            if (decodeDraco && draco->Attributes.contains(attributeName))
+                continue;
+
+            const size_t TEX_COORD_STRING = 9;
+            if (auto usage = GetAttributeUsage(attributeName))
+                read(accessor, *usage, *usage == GLTF::AccessorUsage::TexCoord ? (size_t) std::atoi(&attributeName.at(TEX_COORD_STRING)) : 0);
+        }
+    }
+
+    // Reads the indices and vertex attributes of a primitive. Only reads from the asset, so primitives can be read in parallel.
+    static void ReadPrimitiveGeometry(const GLTF::Asset& asset, const GLTF::Primitive& primitive, bool keepQuantized, GLTF::AccessorCache& cache, Mesh& outMesh)
+    {
+        // Without draco, the uncompressed fallback data is read, which only exists if the extension is not required
+        const auto& draco = primitive.ExtDracoMeshCompression;
+        if (draco && GLTF::IsDracoSupported())
+            GLTF::DecodeDracoPrimitive(asset, *draco, outMesh);
+
+        ForEachReadAccessor(primitive, [&](size_t accessor, GLTF::AccessorUsage usage, size_t set)
+        {
+            // Integer attributes are converted to floats by a kernel, that is selected once per accessor
+            switch (usage)
+            {
+                case GLTF::AccessorUsage::Indices:
+                {
+                    cache.Read(accessor, usage, outMesh.Indices, [&](std::vector<uint32_t>& out) { ReadIndices(asset, accessor, out); });
+                    break;
+                }
+                case GLTF::AccessorUsage::Position:
+                {
+                    ReadVertexAttribute<3>(asset, accessor, usage, keepQuantized, cache, outMesh.Vertices, outMesh.SharedVertices, outMesh.QuantizedVertices);
+                    break;
+                }
+                case GLTF::AccessorUsage::Normal:
+                {
+                    ReadVertexAttribute<3>(asset, accessor, usage, keepQuantized, cache, outMesh.Normals, outMesh.SharedNormals, outMesh.QuantizedNormals);
+                    break;
+                }
+                case GLTF::AccessorUsage::Tangent:
+                {
+                    ReadVertexAttribute<4>(asset, accessor, usage, keepQuantized, cache, outMesh.Tangents, outMesh.SharedTangents, outMesh.QuantizedTangents);
+                    break;
+                }
+                case GLTF::AccessorUsage::TexCoord:
+                {
+                    ReadVertexAttribute<2>(asset, accessor, usage, keepQuantized, cache, outMesh.TexCoords.at(set), outMesh.SharedTexCoords.at(set),
+                                           outMesh.QuantizedTexCoords.at(set));
+                    break;
+                }
+                case GLTF::AccessorUsage::Colour:
+                {
+                    // Colours are either RGB or RGBA, the alpha channel is dropped
+                    cache.ReadShared(accessor, usage, outMesh.VertexColours, outMesh.SharedVertexColours, [&](std::vector<glm::vec3>& out)
+                    {
+                        if (asset.Accessors.at(accessor).Type == GLTF::DataType::Vec3)
+                            GLTF::ReadFloatAccessor<3>(asset, accessor, out);
+                        else
+                            GLTF::ReadFloatAccessor<4>(asset, accessor, out);
+                    });
+                    break;
+                }
+            }
+        });
+    }
+
+    /*! Reads the geometry of the primitives of a lazily imported file. Meshes reference the source, so the asset and the
+     *  files mapped by its buffers stay alive as long as any mesh of the scene does.
+     */
+    class GLTFGeometrySource : public GeometrySource
+    {
+    public:
+        GLTFGeometrySource(SharedPtr<GLTF::Asset> asset, bool keepQuantized)
+            : m_Asset(std::move(asset)), m_KeepQuantized(keepQuantized)
+        {}
+
+        // Returns the geometry index of the primitive
+        size_t AddPrimitive(size_t meshIndex, size_t primitiveIndex)
+        {
+            m_Primitives.emplace_back(meshIndex, primitiveIndex);
+            return m_Primitives.size() - 1;
+        }
+    protected:
+        virtual void ReadGeometry(Mesh& mesh, size_t geometryIndex) override
+        {
+            auto [meshIndex, primitiveIndex] = m_Primitives.at(geometryIndex);
+            const GLTF::Primitive& primitive = m_Asset->Meshes.at(meshIndex).Primitives.at(primitiveIndex);
+
+            // Only the bufferViews, that are read for this primitive, are paged in or decoded
+            if (primitive.ExtDracoMeshCompression && GLTF::IsDracoSupported())
+                PrepareBufferView(primitive.ExtDracoMeshCompression->BufferView);
+            ForEachReadAccessor(primitive, [this](size_t accessor, GLTF::AccessorUsage, size_t) { PrepareAccessor(accessor); });
+
+            // Meshes are loaded one at a time, so there are no shared accessors to cache
+            GLTF::AccessorCache cache;
+            ReadPrimitiveGeometry(*m_Asset, primitive, m_KeepQuantized, cache, mesh);
+        }
+    private:
+        void PrepareAccessor(size_t accessorIndex)
+        {
+            // Invalid indices are reported by the accessor conversion
+            if (accessorIndex >= m_Asset->Accessors.size())
+                return;
+
+            const GLTF::Accessor& accessor = m_Asset->Accessors[accessorIndex];
+            PrepareBufferView(accessor.BufferView);
+            if (accessor.SparseAccessor)
+            {
+                PrepareBufferView(accessor.SparseAccessor->Indices.BufferView);
+                PrepareBufferView(accessor.SparseAccessor->Values.BufferView);
+            }
+        }
+
+        void PrepareBufferView(size_t bufferViewIndex)
+        {
+            if (bufferViewIndex >= m_Asset->BufferViews.size())
+                return;
+            GLTF::BufferView& bufferView = m_Asset->BufferViews[bufferViewIndex];
+
+            {
+                // Meshopt bufferViews are decoded by the first mesh, that needs them. The decoded data replaces the
+                // placeholder buffer, that the bufferView already points to, so the buffer array is never reallocated.
+                std::lock_guard lock(m_DecodeMutex);
+                if (bufferView.Meshopt)
+                {
+                    const GLTF::MeshoptCompression& compression = *bufferView.Meshopt;
+                    std::span<const uint8_t> data = m_Asset->Buffers.at(compression.Buffer).GetView(compression.ByteLength, compression.ByteOffset);
+
+                    std::vector<uint8_t> decodedData(compression.Count * compression.ByteStride);
+                    GLTF::DecodeMeshoptBufferView(compression, data, decodedData);
+
+                    m_Asset->Buffers.at(bufferView.Buffer) = GLTF::Buffer(bufferView.Buffer, std::move(decodedData));
+                    bufferView.Meshopt.reset();
+                    return;
+                }
+            }
+
+            if (bufferView.Buffer < m_Asset->Buffers.size())
+                m_Asset->Buffers[bufferView.Buffer].Advise(MemoryAccessHint::WillNeed, bufferView.ByteLength, bufferView.ByteOffset);
+        }
+    private:
+        SharedPtr<GLTF::Asset> m_Asset;
+        bool m_KeepQuantized = false;
+
+        std::vector<std::pair<size_t, size_t>> m_Primitives;
+        std::mutex m_DecodeMutex;
+    };
+
     bool GLTFImporter::CanLoad(FileReader& reader)
     {
         m_FileReader = &reader;
@@ -33,12 +271,11 @@ namespace OCASI {
         }
         else
         {
-            m_Json = new GLTF::Json;
-            if(padded_string::load(m_FileReader->GetPath().string()).get(m_Json->PaddedJsonString))
-                return false;
-            
-            if (!m_Json->Parser.iterate(m_Json->PaddedJsonString).get(m_Json->Json))
+            m_Json = GLTF::JsonParser::AcquireJson();
+            if (!m_Json->Parse(m_FileReader->GetFileView(), m_FileReader->GetReadablePadding()))
                 return true;
+            
+            m_Json.reset();
         }
         return false;
     }
@@ -46,6 +283,8 @@ namespace OCASI {
     SharedPtr<Scene> GLTFImporter::Load3DFile(FileReader& reader)
     {
         m_FileReader = &reader;
+        // The data of files in memory only has to stay valid during the import, so their geometry is always read
+        m_LazyGeometry = s_LazyGeometryLoading && m_FileReader->GetMappedFile();
         
         if (m_FileReader->IsBinary())
         {
@@ -54,11 +293,19 @@ namespace OCASI {
         }
         else
         {
-            GLTF::JsonParser parser(*m_FileReader, m_Json);
+            // The asset does not reference the json document, so it is returned into the pool right after parsing
+            GLTF::PooledJson json = std::move(m_Json);
+            GLTF::JsonParser parser(*m_FileReader, json.get());
             if (!(m_Asset = parser.ParseGLTFTextFile()))
                 return nullptr;
         }
 
+        // Buffers are read in the order they are referenced by accessors, which is not necessarily sequential. Lazy imports
+        // only page in the ranges of the meshes, that are loaded.
+        for (const GLTF::Buffer& buffer : m_Asset->Buffers)
+            buffer.Advise(m_LazyGeometry ? MemoryAccessHint::Random : MemoryAccessHint::WillNeed);
+
+        DecodeCompressedBufferViews();
         ConvertToOCASIScene();
 
         return m_Scene;
@@ -66,6 +313,9 @@ namespace OCASI {
 
     bool GLTFImporter::LoadBinary()
     {
+        // The binary reader and all chunks reference the mapped file data directly
+        if (!m_LazyGeometry)
+            m_FileReader->Advise(MemoryAccessHint::WillNeed);
         BinaryReader bReader(*m_FileReader);
         // Skip the header, as it has already been checked to be valid in the CheckBinaryHeader function
         bReader.SetPointer(BINARY_HEADER_BYTE_SIZE);
@@ -74,15 +324,18 @@ namespace OCASI {
         if (jsonChunk.Type != CHUNK_TYPE_JSON)
             throw FailedImportError("First binary chunk must be of type json.");
             
-        m_Json = new GLTF::Json;
-        m_Json->PaddedJsonString = padded_string((char*)jsonChunk.Data, jsonChunk.ChunkLength);
+        // The json chunk is usually followed by the binary chunk, so it can be parsed in place without copying it
+        std::span<const uint8_t> fileData = m_FileReader->GetFileSpan();
+        size_t readablePadding = (size_t) (fileData.data() + fileData.size() - (jsonChunk.Data + jsonChunk.ChunkLength)) + m_FileReader->GetReadablePadding();
         
-        if (auto error = m_Json->Parser.iterate(m_Json->PaddedJsonString).get(m_Json->Json); error != error_code::SUCCESS)
+        GLTF::PooledJson json = GLTF::JsonParser::AcquireJson();
+        if (auto error = json->Parse(std::string_view((const char*) jsonChunk.Data, jsonChunk.ChunkLength), readablePadding); error != error_code::SUCCESS)
             throw FailedImportError(FORMAT("Can't read json file: {}", simdjson::error_message(error)));
 
-        GLTF::JsonParser parser(*m_FileReader, m_Json);
+        GLTF::JsonParser parser(*m_FileReader, json.get());
         if (!(m_Asset = parser.ParseGLTFTextFile()))
             return false;
+        json.reset();
 
         // Checking whether there is a second chunk
 
@@ -97,37 +350,113 @@ namespace OCASI {
             bool found = false;
             for (GLTF::Buffer& buffer : m_Asset->Buffers)
             {
-                if (!buffer.m_Data && !found)
-                {
-                    buffer.SetData(bufferChunk.Data);
-                    found = true;
-                }
-                else
-                {
+                if (buffer.HasData() || buffer.IsFallback())
+                    continue;
+
+                if (found)
                     throw FailedImportError("GLB file defines more then one binary chunk.");
-                }
+
+                buffer.SetData({ bufferChunk.Data, bufferChunk.ChunkLength }, m_FileReader->GetMappedFile());
+                found = true;
             }
         }
 
-        delete jsonChunk.Data;
-
         return true;
     }
 
+    void GLTFImporter::DecodeCompressedBufferViews()
+    {
+        // Lazy imports decode the bufferViews of accessors once a mesh is loaded, other bufferViews (e.g. images) are
+        // decoded right away
+        std::vector<bool> deferredViews(m_LazyGeometry ? m_Asset->BufferViews.size() : 0, false);
+        auto deferView = [&deferredViews](size_t viewIndex)
+        {
+            if (viewIndex < deferredViews.size())
+                deferredViews[viewIndex] = true;
+        };
+        for (const GLTF::Accessor& accessor : m_Asset->Accessors)
+        {
+            deferView(accessor.BufferView);
+            if (accessor.SparseAccessor)
+            {
+                deferView(accessor.SparseAccessor->Indices.BufferView);
+                deferView(accessor.SparseAccessor->Values.BufferView);
+            }
+        }
+
+        std::vector<size_t> compressedViews;
+        std::vector<size_t> pendingViews;
+        for (const GLTF::BufferView& bufferView : m_Asset->BufferViews)
+        {
+            if (!bufferView.Meshopt)
+                continue;
+
+            if (deferredViews.size() > bufferView.GetIndex() && deferredViews[bufferView.GetIndex()])
+                pendingViews.push_back(bufferView.GetIndex());
+            else
+                compressedViews.push_back(bufferView.GetIndex());
+        }
+
+        // Pending bufferViews point to an empty buffer of the decoded size, which is replaced once they are decoded. The
+        // meshopt compression is kept, so the geometry source knows that they still have to be decoded.
+        m_Asset->Buffers.reserve(m_Asset->Buffers.size() + compressedViews.size() + pendingViews.size());
+        for (size_t viewIndex : pendingViews)
+        {
+            GLTF::BufferView& bufferView = m_Asset->BufferViews[viewIndex];
+            size_t bufferIndex = m_Asset->Buffers.size();
+            m_Asset->Buffers.emplace_back(bufferIndex, bufferView.Meshopt->Count * bufferView.Meshopt->ByteStride);
+
+            bufferView.Buffer = bufferIndex;
+            bufferView.ByteOffset = 0;
+        }
+
+        if (compressedViews.empty())
+            return;
+
+        // The largest bufferViews are decoded first, so they don't end up as the last task of a thread
+        auto decodedSize = [this](size_t viewIndex)
+        {
+            const GLTF::MeshoptCompression& compression = *m_Asset->BufferViews[viewIndex].Meshopt;
+            return compression.Count * compression.ByteStride;
+        };
+        std::stable_sort(compressedViews.begin(), compressedViews.end(), [&](size_t a, size_t b) { return decodedSize(a) > decodedSize(b); });
+
+        // Every bufferView is decoded into memory of its own, so they are independent from each other
+        std::vector<std::vector<uint8_t>> decodedData(compressedViews.size());
+        ThreadPool::GetGlobal().ParallelFor(compressedViews.size(), [&](size_t i)
+        {
+            const GLTF::MeshoptCompression& compression = *m_Asset->BufferViews[compressedViews[i]].Meshopt;
+            std::span<const uint8_t> data = m_Asset->Buffers.at(compression.Buffer).GetView(compression.ByteLength, compression.ByteOffset);
+
+            decodedData[i].resize(decodedSize(compressedViews[i]));
+            GLTF::DecodeMeshoptBufferView(compression, data, decodedData[i]);
+        });
+
+        // The decoded data becomes a buffer, that the bufferView points to, so accessors read it like uncompressed data
+        for (size_t i = 0; i < compressedViews.size(); i++)
+        {
+            GLTF::BufferView& bufferView = m_Asset->BufferViews[compressedViews[i]];
+            size_t bufferIndex = m_Asset->Buffers.size();
+            m_Asset->Buffers.emplace_back(bufferIndex, std::move(decodedData[i]));
+
+            bufferView.Buffer = bufferIndex;
+            bufferView.ByteOffset = 0;
+            bufferView.Meshopt.reset();
+        }
+    }
+
     GLBChunk GLTFImporter::LoadChunk(BinaryReader& bReader)
     {
         GLBChunk chunk = {};
         chunk.ChunkLength = bReader.GetUint32();
         chunk.Type = bReader.GetUint32();
-        chunk.Data = bReader.Get(chunk.ChunkLength);
+        chunk.Data = bReader.GetSpan(chunk.ChunkLength).data();
 
-        // Remove trailing zeros
-        for (uint32_t i = chunk.ChunkLength - 1; i > 0; i--)
+        // Remove trailing zeros of the json chunk. The binary chunk is left untouched, as zeros are valid data there.
+        if (chunk.Type == CHUNK_TYPE_JSON)
         {
-            if (chunk.Data[i] == '\0')
+            while (chunk.ChunkLength > 0 && chunk.Data[chunk.ChunkLength - 1] == '\0')
                 chunk.ChunkLength--;
-            else
-                break;
         }
 
         return chunk;
@@ -157,16 +486,90 @@ namespace OCASI {
             CreateNodes(gltfScene.GetIndex());
         }
 
-        for (auto& gltfMesh: gltfAsset.Meshes)
+        ConvertMeshes();
+        ConvertMaterials();
+    }
+
+    void GLTFImporter::ConvertMeshes()
+    {
+        auto& gltfAsset = *m_Asset;
+
+        if (m_LazyGeometry)
         {
-            CreateMesh(gltfMesh.GetIndex());
+            // Only the metadata is converted, the geometry is read by the source once a mesh is loaded
+            auto source = MakeShared<GLTFGeometrySource>(m_Asset, s_KeepQuantizedVertexData);
+            m_Scene->Models.resize(gltfAsset.Meshes.size());
+            for (auto& gltfMesh : gltfAsset.Meshes)
+            {
+                auto& ocasiMeshes = m_Scene->Models.at(gltfMesh.GetIndex()).Meshes;
+                ocasiMeshes.resize(gltfMesh.Primitives.size());
+                for (size_t i = 0; i < gltfMesh.Primitives.size(); i++)
+                {
+                    ocasiMeshes[i].MaterialIndex = gltfMesh.Primitives[i].MaterialIndex;
+                    ocasiMeshes[i].FaceMode = ConvertPrimitiveTypeToFaceType(gltfMesh.Primitives[i].Type);
+                    ocasiMeshes[i].Geometry = source;
+                    ocasiMeshes[i].GeometryIndex = source->AddPrimitive(gltfMesh.GetIndex(), i);
+                    ocasiMeshes[i].GeometryPending = true;
+                }
+            }
+            return;
         }
 
-        for (auto& gltfMaterial : gltfAsset.Materials)
+        // Every primitive only reads from the asset and is written into its own pre-sized slot, so all primitives of
+        // all meshes are converted independently
+        std::vector<PrimitiveConversion> conversions;
+        m_Scene->Models.resize(gltfAsset.Meshes.size());
+        for (auto& gltfMesh : gltfAsset.Meshes)
         {
-            CreateMaterial(gltfMaterial.GetIndex());
+            m_Scene->Models.at(gltfMesh.GetIndex()).Meshes.resize(gltfMesh.Primitives.size());
+            for (size_t i = 0; i < gltfMesh.Primitives.size(); i++)
+            {
+                auto position = gltfMesh.Primitives[i].Attributes.find("POSITION");
+                size_t vertexCount = position != gltfMesh.Primitives[i].Attributes.end() && position->second < gltfAsset.Accessors.size() ?
+                                     gltfAsset.Accessors[position->second].ElementCount : 0;
+                conversions.push_back({ gltfMesh.GetIndex(), i, vertexCount });
+            }
         }
 
+        // Accessors, that are shared between primitives, are only decoded once
+        GLTF::AccessorCache cache(s_ShareVertexData);
+        for (const PrimitiveConversion& conversion : conversions)
+        {
+            ForEachReadAccessor(gltfAsset.Meshes[conversion.MeshIndex].Primitives[conversion.PrimitiveIndex],
+                                [&cache](size_t accessor, GLTF::AccessorUsage usage, size_t) { cache.AddReference(accessor, usage); });
+        }
+
+        // Starting with the largest primitives keeps a single big primitive from finishing last on its own
+        std::stable_sort(conversions.begin(), conversions.end(), [](const PrimitiveConversion& a, const PrimitiveConversion& b)
+        {
+            return a.VertexCount > b.VertexCount;
+        });
+
+        ThreadPool::GetGlobal().ParallelFor(conversions.size(), [this, &conversions, &cache](size_t i)
+        {
+            CreateMesh(conversions[i].MeshIndex, conversions[i].PrimitiveIndex, cache);
+        });
+    }
+
+    void GLTFImporter::ConvertMaterials()
+    {
+        // Textures with the same image and sampler share one image, so its data is only copied (and decoded) once
+        std::map<std::pair<size_t, size_t>, size_t> textureSlots;
+        m_TextureSlotIndices.resize(m_Asset->Textures.size());
+        for (const GLTF::Texture& texture : m_Asset->Textures)
+            m_TextureSlotIndices[texture.GetIndex()] = textureSlots.try_emplace({ texture.Source, texture.Sampler }, textureSlots.size()).first->second;
+        m_TextureSlots = std::vector<TextureSlot>(textureSlots.size());
+
+        // Images are only referenced by path or copied as compressed data here, so materials are cheap to convert in
+        // parallel as well
+        m_Scene->Materials.resize(m_Asset->Materials.size());
+        ThreadPool::GetGlobal().ParallelFor(m_Asset->Materials.size(), [this](size_t i)
+        {
+            CreateMaterial(i);
+        });
+
+        // The materials own the images from now on
+        m_TextureSlots.clear();
     }
 
     void GLTFImporter::CreateNodes(size_t sceneIndex)
@@ -226,89 +629,18 @@ namespace OCASI {
         }
     }
 
-    void GLTFImporter::CreateMesh(size_t meshIndex)
+    void GLTFImporter::CreateMesh(size_t meshIndex, size_t primitiveIndex, GLTF::AccessorCache& cache)
     {
         auto& gltfAsset = *m_Asset;
         auto& ocasiScene = *m_Scene;
 
         OCASI_ASSERT(meshIndex < gltfAsset.Meshes.size());
-        auto& gltfMesh = gltfAsset.Meshes.at(meshIndex);
-        OCASI_ASSERT(meshIndex == ocasiScene.Models.size());
-        auto& ocasiModel = ocasiScene.Models.emplace_back();
+        auto& gltfPrimitive = gltfAsset.Meshes.at(meshIndex).Primitives.at(primitiveIndex);
+        auto& ocasiMesh = ocasiScene.Models.at(meshIndex).Meshes.at(primitiveIndex);
 
-        for (auto& gltfPrimitive : gltfMesh.Primitives)
-        {
-            auto& ocasiMesh = ocasiModel.Meshes.emplace_back();
-            ocasiMesh.MaterialIndex = gltfPrimitive.MaterialIndex;
-            ocasiMesh.FaceMode = ConvertPrimitiveTypeToFaceType(gltfPrimitive.Type);
-
-            if (gltfPrimitive.Indices != INVALID_ID)
-            {
-                std::vector<uint8_t> data = GetAccessorData(gltfPrimitive.Indices);
-                OCASI_ASSERT(!data.empty());
-
-                size_t indexDataTypeSize = GLTF::ComponentTypeToBytes(gltfAsset.Accessors.at(gltfPrimitive.Indices).CompType);
-                OCASI_ASSERT(data.size() % indexDataTypeSize == 0)
-                
-                ocasiMesh.Indices.resize(data.size() / indexDataTypeSize);
-                for (size_t i = 0; i < data.size(); i += indexDataTypeSize)
-                    std::memcpy(&ocasiMesh.Indices[(i == 0 ? 0 : i / indexDataTypeSize)], &data[i], indexDataTypeSize);
-            }
-
-            for (auto& [attributeName, accessor] : gltfPrimitive.Attributes)
-            {
-                // TODO: Currently the data types are fixed, make these dynamic or something
-                if (attributeName == "POSITION")
-                {
-                    std::vector<uint8_t> data = GetAccessorData(accessor);
-                    OCASI_ASSERT(!data.empty() && data.size() % sizeof(glm::vec3) == 0);
-
-                    ocasiMesh.Vertices.resize(data.size() / sizeof(glm::vec3));
-                    std::memcpy(ocasiMesh.Vertices.data(), data.data(), data.size());
-                }
-                else if (attributeName == "NORMAL")
-                {
-                    std::vector<uint8_t> data = GetAccessorData(accessor);
-                    OCASI_ASSERT(!data.empty() && data.size() % sizeof(glm::vec3) == 0);
-
-                    ocasiMesh.Normals.resize(data.size() / sizeof(glm::vec3));
-                    std::memcpy(ocasiMesh.Normals.data(), data.data(), data.size());
-                }
-                else if (attributeName == "TANGENT")
-                {
-                     std::vector<uint8_t> data = GetAccessorData(accessor);
-                     OCASI_ASSERT(!data.empty() && data.size() % sizeof(glm::vec4) == 0);
-
-                    ocasiMesh.Tangents.resize(data.size() / sizeof(glm::vec4));
-                    std::memcpy(ocasiMesh.Tangents.data(), data.data(), data.size());
-                }
-                else if (Util::StartsWith(attributeName, "TEXCOORD_"))
-                {
-                    const size_t TEX_COORD_STRING = 9;
-                    size_t texCoordIndex = std::atoi(&attributeName.at(TEX_COORD_STRING));
-
-                    OCASI_ASSERT(texCoordIndex < ocasiMesh.TexCoords.size());
-                    auto& texCoords = ocasiMesh.TexCoords.at(texCoordIndex);
-
-                    std::vector<uint8_t> data = GetAccessorData(accessor);
-                    OCASI_ASSERT(!data.empty() && data.size() % sizeof(glm::vec2) == 0);
-
-                    texCoords.resize(data.size() / sizeof(glm::vec2));
-                    std::memcpy(texCoords.data(), data.data(), data.size());
-                }
-                else if (Util::StartsWith(attributeName, "COLOR_"))
-                {
-                    const size_t COLOR_STRING = 6;
-                    size_t colorIndex = std::atoi(&attributeName.at(COLOR_STRING));
-
-                    std::vector<uint8_t> data = GetAccessorData(accessor);
-                    OCASI_ASSERT(!data.empty() && data.size() % sizeof(glm::vec4) == 0);
-
-                    ocasiMesh.VertexColours.resize(data.size() / sizeof(glm::vec4));
-                    std::memcpy(ocasiMesh.VertexColours.data(), data.data(), data.size());
-                }
-            }
-        }
+        ocasiMesh.MaterialIndex = gltfPrimitive.MaterialIndex;
+        ocasiMesh.FaceMode = ConvertPrimitiveTypeToFaceType(gltfPrimitive.Type);
+        ReadPrimitiveGeometry(gltfAsset, gltfPrimitive, s_KeepQuantizedVertexData, cache, ocasiMesh);
     }
 
     void GLTFImporter::CreateMaterial(size_t materialIndex)
@@ -318,8 +650,7 @@ namespace OCASI {
 
         OCASI_ASSERT(materialIndex < gltfAsset.Materials.size());
         auto& gltfMaterial = gltfAsset.Materials.at(materialIndex);
-        OCASI_ASSERT(materialIndex == ocasiScene.Materials.size());
-        auto& ocasiMaterial = ocasiScene.Materials.emplace_back();
+        auto& ocasiMaterial = ocasiScene.Materials.at(materialIndex);
 
         ocasiMaterial.SetName(gltfMaterial.Name);
 
@@ -404,19 +735,26 @@ namespace OCASI {
         }
     }
 
-    std::unique_ptr<Image> GLTFImporter::CreateTexture(std::optional<GLTF::TextureInfo>& texInfo)
+    SharedPtr<Image> GLTFImporter::CreateTexture(std::optional<GLTF::TextureInfo>& texInfo)
     {
         if (!texInfo.has_value())
             return nullptr;
 
-        auto& gltfAsset = *m_Asset;
+        OCASI_ASSERT(texInfo->Texture < m_Asset->Textures.size());
+        TextureSlot& slot = m_TextureSlots.at(m_TextureSlotIndices.at(texInfo->Texture));
+        std::call_once(slot.Created, [&]()
+        {
+            slot.Texture = CreateImage(m_Asset->Textures.at(texInfo->Texture));
+        });
 
-        const GLTF::TextureInfo& gltfInfo = texInfo.value();
+        return slot.Texture;
+    }
 
-        OCASI_ASSERT(gltfInfo.Texture < gltfAsset.Textures.size());
-        GLTF::Texture& gltfTexture = gltfAsset.Textures.at(gltfInfo.Texture);
+    SharedPtr<Image> GLTFImporter::CreateImage(const GLTF::Texture& gltfTexture)
+    {
+        auto& gltfAsset = *m_Asset;
 
-        OCASI_ASSERT_MSG(gltfTexture.Source != INVALID_ID, FORMAT("Do not know what to do with a texture that does not contain an image source. Texture json index: {}", texInfo->Texture));
+        OCASI_ASSERT_MSG(gltfTexture.Source != INVALID_ID, FORMAT("Do not know what to do with a texture that does not contain an image source. Texture json index: {}", gltfTexture.GetIndex()));
         OCASI_ASSERT(gltfTexture.Source < gltfAsset.Images.size());
         GLTF::Image& gltfImage = gltfAsset.Images.at(gltfTexture.Source);
 
@@ -444,28 +782,28 @@ namespace OCASI {
             OCASI_ASSERT(!gltfImage.MimeType.empty());
             ImageType type = ConvertMimeTypeToImagType(gltfImage.MimeType);
 
-            return MakeUnique<Image>(std::move(data), settings);
+            return MakeShared<Image>(std::move(data), settings);
         }
         else if (!gltfImage.URI.empty())
         {
+            // Data uris are decoded straight from the uri, unescaping them would only copy the payload
+            if (Util::StartsWith(gltfImage.URI, "data:"))
+                return MakeShared<Image>(Util::DecodeBase64(Util::GetBase64DataURIPayload(gltfImage.URI)), settings);
+
             std::string uri = Util::URIUnescapedString(gltfImage.URI);
-            if (Util::StartsWith(uri, "data:"))
+            if (auto resolvedData = m_FileReader->ResolveRelative(uri))
             {
-                std::string data = gltfImage.URI.substr(uri.find(':'));
-                size_t readSize = 0;
-                uint8_t* binaryData = Util::DecodeBase64(data, readSize);
-                if (!binaryData)
-                    throw FailedImportError("Could not read Base64 encoded string.");
-                
-                std::vector<uint8_t> binaryDataVector(readSize);
-
-                std::memcpy(binaryDataVector.data(), binaryData, readSize);
-
-                return std::make_unique<Image>(std::move(binaryDataVector), settings);
+                // Images of in-memory files are resolved by the user, their compressed data is stored inside the image
+                return MakeShared<Image>(std::vector<uint8_t>(resolvedData->begin(), resolvedData->end()), settings);
+            }
+            else if (m_FileReader->IsMemoryFile())
+            {
+                // In-memory imports never touch the disk, an unresolved image fails like an unresolved buffer
+                throw FailedImportError(FORMAT("Could not resolve image {} of an in-memory file.", uri));
             }
             else if (Path path = m_FileReader->GetParentPath() / uri; std::filesystem::exists(path))
             {
-                return std::make_unique<Image>(path, settings);
+                return MakeShared<Image>(path, settings);
             }
             else
             {
@@ -491,75 +829,6 @@ namespace OCASI {
         return buffer.Get(bufferView.ByteLength, bufferView.ByteOffset + accessorOffset);
     }
 
-    std::vector<uint8_t> GLTFImporter::GetAccessorData(size_t accessorIndex)
-    {
-        auto& asset = *m_Asset;
-
-        OCASI_ASSERT(accessorIndex < asset.Accessors.size());
-        auto& accessor = asset.Accessors.at(accessorIndex);
-        OCASI_ASSERT_MSG(accessor.BufferView != INVALID_ID, "Don't know what to do with an accessor that does not contain a buffer view.");
-
-        // This is the accessor offset, not the buffer view offset
-        size_t elementSize = GLTF::ComponentTypeToBytes(accessor.CompType) * (size_t) accessor.Type;
-
-        size_t byteStride = 0;
-        std::vector<uint8_t> data = GetBufferViewData(accessor.BufferView, accessor.ByteOffset, byteStride);
-        OCASI_ASSERT(!data.empty());
-
-        // The byte stride specifies the number of bytes for each element. It is not the element size, but
-        // the padding between an element, and it's neighbour including the elements size (stride = element size + padding).
-        if (byteStride != 0 && byteStride != elementSize)
-        {
-            OCASI_ASSERT(byteStride % GLTF::ComponentTypeToBytes(accessor.CompType) == 0);
-            for (size_t i = 0; i < accessor.ElementCount; i++)
-            {
-                std::memcpy(&data[i * elementSize], &data[i * byteStride], elementSize);
-            }
-            data.resize(elementSize * accessor.ElementCount);
-        }
-
-        if (accessor.SparseAccessor.has_value())
-        {
-            auto& sparse = accessor.SparseAccessor.value();
-            OCASI_ASSERT(sparse.Indices.BufferView < asset.BufferViews.size());
-
-            size_t sparseIndicesByteStride; // ignored
-            std::vector<uint8_t> sparseIndicesData = GetBufferViewData(sparse.Indices.BufferView, sparse.Indices.ByteOffset, sparseIndicesByteStride);
-            OCASI_ASSERT(!sparseIndicesData.empty());
-
-            size_t sparseValuesByteStride; // ignored
-            std::vector<uint8_t> sparseValuesData = GetBufferViewData(sparse.Values.BufferView, sparse.Values.ByteOffset, sparseValuesByteStride);
-            OCASI_ASSERT(!sparseValuesData.empty());
-
-            // TODO: Create a new vector, copying over the indices
-            // HACK: For indexing a conversion from bytes to a number is needed
-            for (size_t i = 0; i < sparse.ElementCount; i++)
-            {
-                uint32_t index = 0;
-                switch(sparse.Indices.CompType)
-                {
-                    case GLTF::ComponentType::Short:
-                    case GLTF::ComponentType::UnsignedShort:
-                    {
-                        std::memcpy(&index, &sparseIndicesData[i * sizeof(uint16_t)], sizeof(uint16_t));
-                        break;
-                    }
-                    case GLTF::ComponentType::UnsignedInt:
-                    {
-                        std::memcpy(&index, &sparseIndicesData[i * sizeof(uint32_t)], sizeof(uint32_t));
-                        break;
-                    }
-                    default:
-                        throw FailedImportError(FORMAT("Unsupported component type used for sparse accessor {}.", (int) sparse.Indices.CompType));
-                }
-
-                std::memcpy(&data[index * elementSize], &sparseValuesData[i * elementSize], elementSize);
-            }
-        }
-
-        return data;
-    }
-
     // TODO: Use the already existing FilterOption struct for the GLTF implementation. This is completely unnecessary!
     FilterOption GLTFImporter::ConvertMinMagFilterToFilterOption(GLTF::MinMagFilter filter)
     {
@@ -6,6 +6,10 @@
 
 #include "OCASI/Importers/GLTF2/JsonParser.h"
 
+namespace OCASI::GLTF {
+    class AccessorCache;
+}
+
 namespace OCASI {
     struct Json;
 
@@ -20,7 +24,7 @@ namespace OCASI {
     {
         uint32_t ChunkLength; // The chunk length in bytes
         uint32_t Type; // Maybe use an enum for this
-        uint8_t* Data; // The chunks data with byte length of ChunkLength
+        const uint8_t* Data; // Points into the file data of the glb file with byte length of ChunkLength
     };
 
     class GLTFImporter : public BaseImporter
@@ -32,19 +36,44 @@ namespace OCASI {
         virtual std::string_view GetLoggerPattern()  const override { return "GLTF"; }
         virtual const std::vector<std::string_view> GetSupportedFileExtensions() const override { return { ".gltf", ".glb" }; }
         virtual ImporterType GetImporterType() const override { return ImporterType::GLTF; }
+        virtual uint32_t GetImporterVersion() const override { return 2; }
+        
+        //! @brief See Importer::SetKeepQuantizedVertexData().
+        static void SetKeepQuantizedVertexData(bool keep) { s_KeepQuantizedVertexData = keep; }
+        //! @brief See Importer::SetLazyGeometryLoading().
+        static void SetLazyGeometryLoading(bool lazy) { s_LazyGeometryLoading = lazy; }
+        //! @brief See Importer::SetShareVertexData().
+        static void SetShareVertexData(bool share) { s_ShareVertexData = share; }
     private:
+        struct PrimitiveConversion
+        {
+            size_t MeshIndex;
+            size_t PrimitiveIndex;
+            size_t VertexCount;
+        };
+
+        //! The image, that all textures with the same image source and sampler share.
+        struct TextureSlot
+        {
+            std::once_flag Created;
+            SharedPtr<Image> Texture;
+        };
+
         bool LoadBinary();
         GLBChunk LoadChunk(BinaryReader& bReader);
+        void DecodeCompressedBufferViews();
 
         void ConvertToOCASIScene();
+        void ConvertMeshes();
+        void ConvertMaterials();
 
         bool CheckBinaryHeader();
         void CreateNodes(size_t sceneIndex);
         void TraverseNodes(GLTF::Node& gltfNode, SharedPtr<Node> ocasiNode);
-        void CreateMesh(size_t meshIndex);
+        void CreateMesh(size_t meshIndex, size_t primitiveIndex, GLTF::AccessorCache& cache);
         void CreateMaterial(size_t materialIndex);
-        std::unique_ptr<Image> CreateTexture(std::optional<GLTF::TextureInfo>& texInfo);
-        std::vector<uint8_t> GetAccessorData(size_t accessorIndex);
+        SharedPtr<Image> CreateTexture(std::optional<GLTF::TextureInfo>& texInfo);
+        SharedPtr<Image> CreateImage(const GLTF::Texture& gltfTexture);
         std::vector<uint8_t> GetBufferViewData(size_t bufferViewIndex, size_t accessorOffset, size_t& outByteStride);
 
         FilterOption ConvertMinMagFilterToFilterOption(GLTF::MinMagFilter filter);
@@ -52,10 +81,19 @@ namespace OCASI {
         ImageType ConvertMimeTypeToImagType(const std::string& mimeType);
     private:
         FileReader* m_FileReader = nullptr;
-        GLTF::Json* m_Json = nullptr;
+        GLTF::PooledJson m_Json;
         
         SharedPtr<GLTF::Asset> m_Asset = nullptr;
         SharedPtr<Scene> m_Scene = nullptr;
+        bool m_LazyGeometry = false;
+
+        // Per glTF texture, the index of its slot in m_TextureSlots. Only valid while the materials are converted.
+        std::vector<size_t> m_TextureSlotIndices;
+        std::vector<TextureSlot> m_TextureSlots;
+        
+        static bool s_KeepQuantizedVertexData;
+        static bool s_LazyGeometryLoading;
+        static bool s_ShareVertexData;
     };
 
 }
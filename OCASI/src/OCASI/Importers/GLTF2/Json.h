@@ -1,27 +1,59 @@
 #include "simdjson/simdjson.h"
 
+#include <cstring>
+
 namespace OCASI::GLTF {
     
+    // The DOM API is used, because simdjson selects its SIMD kernel for it at runtime, while the On-Demand API is
+    // bound to the kernel chosen at compile time, which is the scalar fallback kernel for default x64 builds.
+    // Instances are pooled per thread by the JsonParser, so the parser and the buffer keep their allocations across imports.
     struct Json
     {
-        simdjson::ondemand::parser Parser;
-        simdjson::padded_string PaddedJsonString;
-        simdjson::ondemand::document Json;
+        simdjson::dom::parser Parser;
+        std::unique_ptr<char[]> PaddedBuffer;
+        size_t PaddedBufferCapacity = 0;
+        simdjson::dom::element Json;
+        
+        simdjson::dom::element& Get() { return Json; }
         
-        simdjson::ondemand::document& Get() { return Json; }
+        /*! simdjson reads up to SIMDJSON_PADDING bytes past the end of the json data. When the caller guarantees, that
+         *  enough bytes behind the data are readable, the data is parsed in place. Otherwise it is copied into the padded
+         *  buffer, which only grows.
+         */
+        simdjson::error_code Parse(std::string_view data, size_t readablePadding = 0)
+        {
+            if (readablePadding >= simdjson::SIMDJSON_PADDING)
+                return Parser.parse(data.data(), data.size(), false).get(Json);
+            
+            size_t requiredCapacity = data.size() + simdjson::SIMDJSON_PADDING;
+            if (requiredCapacity > PaddedBufferCapacity)
+            {
+                PaddedBuffer = std::make_unique<char[]>(requiredCapacity);
+                PaddedBufferCapacity = requiredCapacity;
+            }
+            
+            std::memcpy(PaddedBuffer.get(), data.data(), data.size());
+            std::memset(PaddedBuffer.get() + data.size(), 0, simdjson::SIMDJSON_PADDING);
+            return Parser.parse(PaddedBuffer.get(), data.size(), false).get(Json);
+        }
     };
     
-}
-
-// The code is unnecessary with C++20:
-#if !SIMDJSON_SUPPORTS_DESERIALIZATION
-template <>
-simdjson_inline simdjson::simdjson_result<float> simdjson::ondemand::value::get() noexcept
-{
-    double val;
-    auto error = get_double().get(val);
-    if (error)
+    //! The DOM API only parses doubles, so floats are narrowed after parsing.
+    inline simdjson::error_code GetFloat(const simdjson::dom::element& element, float& outValue)
+    {
+        double value;
+        auto error = element.get(value);
+        if (!error)
+            outValue = (float) value;
         return error;
-    return (float) val;
+    }
+    
+    inline simdjson::error_code GetFloat(const simdjson::simdjson_result<simdjson::dom::element>& result, float& outValue)
+    {
+        simdjson::dom::element element;
+        if (auto error = result.get(element))
+            return error;
+        return GetFloat(element, outValue);
+    }
+    
 }
-#endif
@@ -4,49 +4,185 @@
 
 #include "OCASI/Importers/GLTF2/Json.h"
 
+#include <atomic>
+
 // Apparently __LINE__ has to be parsed around 2 times
-#define OCASI_FAIL_ON_SIMDJSON_ERROR_IMPL(err, msg, line) error_code error##line = err; if (error##line) { throw OCASI::FailedImportError(msg); }
+#define OCASI_FAIL_ON_SIMDJSON_ERROR_IMPL(err, msg, line) if (err) { throw OCASI::FailedImportError(msg); }
 #define OCASI_FAIL_ON_SIMDJSON_ERROR_IMPL2(err, msg, line) OCASI_FAIL_ON_SIMDJSON_ERROR_IMPL(err, msg, line)
 
 #define OCASI_FAIL_ON_SIMDJSON_ERROR(err, msg) OCASI_FAIL_ON_SIMDJSON_ERROR_IMPL2(err, msg, __LINE__)
 #define OCASI_FAIL_IF_OBJ_NOT_EXISTS(json, requiredParam, outValue, msg) OCASI_FAIL_ON_SIMDJSON_ERROR(json[requiredParam].get(outValue), msg)
 
 #define OCASI_HAS_PROPERTY(json, parameter, outValue) if (!json[parameter].get(outValue))
-#define OCASI_SET_PROPERTY_IF_EXISTS(json, parameter, outValue) json[parameter].get(outValue)
-#define OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(json, parameter, T, outValue) json[parameter].get<T>().get(outValue)
+#define OCASI_SET_FLOAT_PROPERTY_IF_EXISTS(json, parameter, outValue) \
+    if (error_code floatError = GetFloat(json[parameter], outValue); floatError && floatError != NO_SUCH_FIELD) \
+    { throw OCASI::FailedImportError(FORMAT("The '{}' property has to be a number", parameter)); }
+
+// Dispatches on an object key inside a switch over HashKey(key). A hash collision with a different key falls through to
+// the end of the switch, so unknown keys are skipped like before.
+#define OCASI_CASE_KEY(name) case HashKey(name): if (key != name) break;
 
 using namespace simdjson;
 
 namespace OCASI::GLTF {
 
-    const std::string_view EXTENSIONS_USED_PROPERTY = "extensionsUsed";
-    const std::string_view EXTENSIONS_REQUIRED_PROPERTY = "extensionsRequired";
-    const std::string_view ACCESSORS_PROPERTY = "accessors";
-    const std::string_view BUFFER_VIEWS_PROPERTY = "bufferViews";
-    const std::string_view BUFFERS_PROPERTY = "buffers";
-    const std::string_view NODES_PROPERTY = "nodes";
-    const std::string_view ASSET_PROPERTY = "asset";
-    const std::string_view MESHES_PROPERTY = "meshes";
-    const std::string_view MATERIALS_PROPERTY = "materials";
-    const std::string_view TEXTURES_PROPERTY = "textures";
-    const std::string_view IMAGES_PROPERTY = "images";
-    const std::string_view SAMPLERS_PROPERTY = "samplers";
-    const std::string_view SCENE_PROPERTY = "scene";
-    const std::string_view SCENES_PROPERTY = "scenes";
+    constexpr std::string_view EXTENSIONS_USED_PROPERTY = "extensionsUsed";
+    constexpr std::string_view EXTENSIONS_REQUIRED_PROPERTY = "extensionsRequired";
+    constexpr std::string_view ACCESSORS_PROPERTY = "accessors";
+    constexpr std::string_view BUFFER_VIEWS_PROPERTY = "bufferViews";
+    constexpr std::string_view BUFFERS_PROPERTY = "buffers";
+    constexpr std::string_view NODES_PROPERTY = "nodes";
+    constexpr std::string_view ASSET_PROPERTY = "asset";
+    constexpr std::string_view MESHES_PROPERTY = "meshes";
+    constexpr std::string_view MATERIALS_PROPERTY = "materials";
+    constexpr std::string_view TEXTURES_PROPERTY = "textures";
+    constexpr std::string_view IMAGES_PROPERTY = "images";
+    constexpr std::string_view SAMPLERS_PROPERTY = "samplers";
+    constexpr std::string_view SCENE_PROPERTY = "scene";
+    constexpr std::string_view SCENES_PROPERTY = "scenes";
+
+    // FNV-1a, which is cheap enough for the short keys of glTF objects
+    constexpr uint32_t HashKey(std::string_view key)
+    {
+        uint32_t hash = 2166136261u;
+        for (char c : key)
+        {
+            hash ^= (uint8_t) c;
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    // A thread only needs more than one Json, if a file resolver imports another glTF file during an import
+    constexpr size_t MAX_POOLED_JSONS_PER_THREAD = 4;
+    static std::atomic<size_t> s_JsonPoolLimit = 64 * 1024 * 1024;
+    static thread_local std::vector<UniquePtr<Json>> s_JsonPool;
+
+    static std::optional<dom::array> GetArray(const dom::element& element)
+    {
+        dom::array array;
+        if (element.get(array))
+            return std::nullopt;
+        return array;
+    }
 
     JsonParser::JsonParser(FileReader& reader, Json* json)
         : m_FileReader(reader), m_Json(json)
     {}
 
-    JsonParser::~JsonParser()
+    std::string JsonParser::GetKernelName()
+    {
+        return simdjson::get_active_implementation()->name();
+    }
+    
+    std::vector<std::string> JsonParser::GetSupportedKernels()
+    {
+        std::vector<std::string> kernels;
+        for (auto implementation : simdjson::get_available_implementations())
+        {
+            if (implementation->supported_by_runtime_system())
+                kernels.push_back(implementation->name());
+        }
+        return kernels;
+    }
+    
+    bool JsonParser::SetKernel(std::string_view name)
+    {
+        auto implementation = simdjson::get_available_implementations()[name];
+        if (!implementation || !implementation->supported_by_runtime_system())
+            return false;
+        
+        simdjson::get_active_implementation() = implementation;
+        return true;
+    }
+
+    PooledJson JsonParser::AcquireJson()
+    {
+        if (s_JsonPool.empty())
+            return PooledJson(new Json);
+
+        PooledJson json(s_JsonPool.back().release());
+        s_JsonPool.pop_back();
+        return json;
+    }
+
+    void JsonParser::SetJsonPoolLimit(size_t byteSize)
+    {
+        s_JsonPoolLimit = byteSize;
+    }
+
+    void JsonReleaser::operator()(Json* json) const
     {
-        delete m_Json;
+        UniquePtr<Json> ownedJson(json);
+        size_t limit = s_JsonPoolLimit;
+        if (s_JsonPool.size() >= MAX_POOLED_JSONS_PER_THREAD || json->Parser.capacity() > limit || json->PaddedBufferCapacity > limit + SIMDJSON_PADDING)
+            return;
+
+        s_JsonPool.push_back(std::move(ownedJson));
     }
 
     std::shared_ptr<Asset> JsonParser::ParseGLTFTextFile()
     {
         m_Asset = MakeShared<Asset>();
-        ondemand::document& json = m_Json->Get();
+
+        dom::object jRoot;
+        OCASI_FAIL_ON_SIMDJSON_ERROR(m_Json->Get().get(jRoot), "The root of a GLTF file has to be an object");
+
+        // The root object is visited once and the top level properties are collected, instead of searching the
+        // root object for each of them
+        dom::object jAsset;
+        bool hasAsset = false;
+        std::optional<dom::array> jExtensionsUsed, jExtensionsRequired, jBuffers, jBufferViews, jAccessors, jImages, jSamplers, jTextures, jMaterials, jMeshes, jNodes, jScenes;
+
+        for (auto [key, value] : jRoot)
+        {
+            switch (HashKey(key))
+            {
+                OCASI_CASE_KEY(ASSET_PROPERTY)
+                    OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(jAsset), "The 'asset' property has to be an object");
+                    hasAsset = true;
+                    break;
+                OCASI_CASE_KEY(EXTENSIONS_USED_PROPERTY)
+                    jExtensionsUsed = GetArray(value);
+                    break;
+                OCASI_CASE_KEY(EXTENSIONS_REQUIRED_PROPERTY)
+                    jExtensionsRequired = GetArray(value);
+                    break;
+                OCASI_CASE_KEY(SCENE_PROPERTY)
+                    OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(m_Asset->DefaultSceneIndex), "The 'scene' property has to be an index");
+                    break;
+                OCASI_CASE_KEY(BUFFERS_PROPERTY)
+                    jBuffers = GetArray(value);
+                    break;
+                OCASI_CASE_KEY(BUFFER_VIEWS_PROPERTY)
+                    jBufferViews = GetArray(value);
+                    break;
+                OCASI_CASE_KEY(ACCESSORS_PROPERTY)
+                    jAccessors = GetArray(value);
+                    break;
+                OCASI_CASE_KEY(IMAGES_PROPERTY)
+                    jImages = GetArray(value);
+                    break;
+                OCASI_CASE_KEY(SAMPLERS_PROPERTY)
+                    jSamplers = GetArray(value);
+                    break;
+                OCASI_CASE_KEY(TEXTURES_PROPERTY)
+                    jTextures = GetArray(value);
+                    break;
+                OCASI_CASE_KEY(MATERIALS_PROPERTY)
+                    jMaterials = GetArray(value);
+                    break;
+                OCASI_CASE_KEY(MESHES_PROPERTY)
+                    jMeshes = GetArray(value);
+                    break;
+                OCASI_CASE_KEY(NODES_PROPERTY)
+                    jNodes = GetArray(value);
+                    break;
+                OCASI_CASE_KEY(SCENES_PROPERTY)
+                    jScenes = GetArray(value);
+                    break;
+            }
+        }
 
         // The order of how things are parsed doesn't really matter, however, it does make sense
         // to first read in asset and extensions, followed by all data objects and ending with
@@ -54,35 +190,44 @@ namespace OCASI::GLTF {
         // where the order of things would be fundamental.
 
         // Read the project generator and version
-        ParseAssetDescription();
-        ParseExtensions();
+        if (!hasAsset)
+            throw FailedImportError("Required 'asset' object not present in GLTF file, though mandatory");
+        ParseAssetDescription(jAsset);
 
-        OCASI_SET_PROPERTY_IF_EXISTS(json, SCENE_PROPERTY, m_Asset->DefaultSceneIndex);
+        if (jExtensionsUsed)
+            ParseExtensions(*jExtensionsUsed);
+        if (jExtensionsRequired)
+            ParseRequiredExtensions(*jExtensionsRequired);
 
-        ParseBuffers();
-        ParseBufferViews();
-        ParseAccessors();
+        if (jBuffers)
+            ParseBuffers(*jBuffers);
+        if (jBufferViews)
+            ParseBufferViews(*jBufferViews);
+        if (jAccessors)
+            ParseAccessors(*jAccessors);
 
-        ParseImages();
-        ParseSamplers();
-        ParseTextures();
+        if (jImages)
+            ParseImages(*jImages);
+        if (jSamplers)
+            ParseSamplers(*jSamplers);
+        if (jTextures)
+            ParseTextures(*jTextures);
 
-        ParseMaterials();
-        ParseMeshes();
+        if (jMaterials)
+            ParseMaterials(*jMaterials);
+        if (jMeshes)
+            ParseMeshes(*jMeshes);
 
-        ParseNodes();
-        ParseScenes();
+        if (jNodes)
+            ParseNodes(*jNodes);
+        if (jScenes)
+            ParseScenes(*jScenes);
 
         return m_Asset;
     }
     
-    void JsonParser::ParseAssetDescription()
+    void JsonParser::ParseAssetDescription(simdjson::dom::object& jAsset)
     {
-        auto& json = m_Json->Get();
-
-        ondemand::object jAsset;
-        OCASI_FAIL_IF_OBJ_NOT_EXISTS(json, ASSET_PROPERTY, jAsset, "Required 'asset' object not present in GLTF file, though mandatory")
-        
         // The jAsset files version
         std::string_view strVersion;
         OCASI_FAIL_IF_OBJ_NOT_EXISTS(jAsset, "version", strVersion, "Required 'version' property in jAsset is not present, though mandatory");
@@ -114,15 +259,8 @@ namespace OCASI::GLTF {
         }
     }
     
-    void JsonParser::ParseExtensions()
+    void JsonParser::ParseExtensions(simdjson::dom::array& jExtensions)
     {
-        auto& json = m_Json->Get();
-
-        // Return when there are no jExtensions required
-        ondemand::array jExtensions;
-        if (json[EXTENSIONS_USED_PROPERTY].get(jExtensions))
-            return;
-        
         for (auto jExt : jExtensions)
         {
             std::string_view extName;
@@ -130,24 +268,29 @@ namespace OCASI::GLTF {
             
             m_Asset->ExtensionsUsed.push_back(std::move(std::string(extName)));
 
-            if (std::find(SUPPORTED_EXTENSIONS.begin(), SUPPORTED_EXTENSIONS.end(), extName) == SUPPORTED_EXTENSIONS.end())
+            if (std::find(SUPPORTED_EXTENSIONS.begin(), SUPPORTED_EXTENSIONS.end(), extName) != SUPPORTED_EXTENSIONS.end())
                 m_Asset->SupportedExtensionsUsed.push_back(std::move(std::string(extName)));
 
         }
-
-        // OCASI currently does not support any jExtensions that are required, so we return when there is an 'extensionRequired' section
-        if (!json[EXTENSIONS_REQUIRED_PROPERTY].error())
-            throw FailedImportError("The GLTF importer currently does not support any extensions that are mandatory for parsing.");
     }
     
-    void JsonParser::ParseBuffers()
+    void JsonParser::ParseRequiredExtensions(simdjson::dom::array& jExtensions)
+    {
+        for (auto jExt : jExtensions)
+        {
+            std::string_view extName;
+            OCASI_FAIL_ON_SIMDJSON_ERROR(jExt.get(extName), "Failed to get jExtensions name: {}");
+            
+            // The file cannot be displayed correctly without a required extension
+            if (std::find(SUPPORTED_EXTENSIONS.begin(), SUPPORTED_EXTENSIONS.end(), extName) == SUPPORTED_EXTENSIONS.end())
+                throw FailedImportError(FORMAT("The GLTF importer does not support the required extension {}.", extName));
+            
+            m_Asset->ExtensionsRequired.emplace_back(extName);
+        }
+    }
+    
+    void JsonParser::ParseBuffers(simdjson::dom::array& jBuffers)
     {
-        auto& json = m_Json->Get();
-
-        ondemand::array jBuffers;
-        if (json[BUFFERS_PROPERTY].get(jBuffers))
-            return;
-        
         size_t i = 0;
         for (auto jBuffer : jBuffers)
         {
@@ -157,15 +300,13 @@ namespace OCASI::GLTF {
             std::string_view data;
             OCASI_HAS_PROPERTY(jBuffer, "uri", data)
             {
-                std::string s(data);
-                if (Util::StartsWith(s, "data:"))
+                if (data.starts_with("data:"))
                 {
-                    std::string uri = s.substr(s.find(':'));
-                    m_Asset->Buffers.emplace_back(i, uri, byteLength);
+                    m_Asset->Buffers.emplace_back(i, data, byteLength);
                 }
                 else
                 {
-                    FileReader binFileReader(m_FileReader.GetParentPath() / data, true);
+                    FileReader binFileReader = m_FileReader.OpenRelative(data, true);
                     m_Asset->Buffers.emplace_back(i, binFileReader, byteLength);
                 }
             }
@@ -173,118 +314,225 @@ namespace OCASI::GLTF {
             {
                 m_Asset->Buffers.emplace_back(i, byteLength);
             }
+
+            bool fallback = false;
+            dom::object jMeshopt;
+            if (!jBuffer["extensions"]["EXT_meshopt_compression"].get(jMeshopt) && !jMeshopt["fallback"].get(fallback))
+                m_Asset->Buffers.back().SetFallback(fallback);
             i++;
         }
     }
     
-    void JsonParser::ParseBufferViews()
+    void JsonParser::ParseBufferViews(simdjson::dom::array& jBufferViews)
     {
-        auto& json = m_Json->Get();
-
-        ondemand::array jBufferViews;
-        if (json[BUFFER_VIEWS_PROPERTY].get(jBufferViews))
-            return;
+        m_Asset->BufferViews.reserve(jBufferViews.size());
 
         size_t i = 0;
-        for (auto jBufferView : jBufferViews)
+        for (auto rJBufferView : jBufferViews)
         {
-            
+            dom::object jBufferView;
+            OCASI_FAIL_ON_SIMDJSON_ERROR(rJBufferView.get(jBufferView), "Failed to get bufferView");
             BufferView& bufferView = m_Asset->BufferViews.emplace_back(i);
-            
-            OCASI_FAIL_IF_OBJ_NOT_EXISTS(jBufferView, "buffer", bufferView.Buffer, "Required 'buffer' property in bufferView is not present, though mandatory");
-            OCASI_FAIL_IF_OBJ_NOT_EXISTS(jBufferView, "byteLength", bufferView.ByteLength, "Required 'byteLength' property in bufferView is not present, though mandatory");
-            
-            OCASI_SET_PROPERTY_IF_EXISTS(jBufferView, "byteOffset", bufferView.ByteOffset);
-            OCASI_SET_PROPERTY_IF_EXISTS(jBufferView, "byteStride", bufferView.ByteStride);
+
+            for (auto [key, value] : jBufferView)
+            {
+                switch (HashKey(key))
+                {
+                    OCASI_CASE_KEY("buffer")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(bufferView.Buffer), "The 'buffer' property of a bufferView has to be an index");
+                        break;
+                    OCASI_CASE_KEY("byteLength")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(bufferView.ByteLength), "The 'byteLength' property of a bufferView has to be an integer");
+                        break;
+                    OCASI_CASE_KEY("byteOffset")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(bufferView.ByteOffset), "The 'byteOffset' property of a bufferView has to be an integer");
+                        break;
+                    OCASI_CASE_KEY("byteStride")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(bufferView.ByteStride), "The 'byteStride' property of a bufferView has to be an integer");
+                        break;
+                    OCASI_CASE_KEY("extensions")
+                    {
+                        dom::object jMeshopt;
+                        if (!value["EXT_meshopt_compression"].get(jMeshopt))
+                            ParseMeshoptCompression(jMeshopt, bufferView.Meshopt = MeshoptCompression());
+                        break;
+                    }
+                }
+            }
+
+            if (bufferView.Buffer == INVALID_ID)
+                throw FailedImportError("Required 'buffer' property in bufferView is not present, though mandatory");
+            if (bufferView.ByteLength == INVALID_ID)
+                throw FailedImportError("Required 'byteLength' property in bufferView is not present, though mandatory");
+            // The data is decoded into the bufferView, this also keeps count * byteStride from overflowing
+            if (bufferView.Meshopt && (bufferView.Meshopt->ByteStride == 0 || bufferView.Meshopt->Count > bufferView.ByteLength / bufferView.Meshopt->ByteStride))
+                throw FailedImportError("The data decoded from EXT_meshopt_compression does not fit into its bufferView");
             i++;
         }
     }
     
-    void JsonParser::ParseAccessors()
+    void JsonParser::ParseDracoMeshCompression(simdjson::dom::object& jDraco, std::optional<KHRDracoMeshCompression>& outDraco)
     {
-        auto& json = m_Json->Get();
-        
-        ondemand::array jAccessors;
-        if (json[ACCESSORS_PROPERTY].get(jAccessors))
-            return;
-        
+        OCASI_FAIL_IF_OBJ_NOT_EXISTS(jDraco, "bufferView", outDraco->BufferView, "Required 'bufferView' property of KHR_draco_mesh_compression is not present, though mandatory");
+
+        dom::object jAttributes;
+        OCASI_FAIL_IF_OBJ_NOT_EXISTS(jDraco, "attributes", jAttributes, "Required 'attributes' property of KHR_draco_mesh_compression is not present, though mandatory");
+        ParseVertexAttributes(jAttributes, outDraco->Attributes);
+    }
+
+    void JsonParser::ParseMeshoptCompression(simdjson::dom::object& jMeshopt, std::optional<MeshoptCompression>& outCompression)
+    {
+        MeshoptCompression& compression = *outCompression;
+        OCASI_FAIL_IF_OBJ_NOT_EXISTS(jMeshopt, "buffer", compression.Buffer, "Required 'buffer' property of EXT_meshopt_compression is not present, though mandatory");
+        OCASI_FAIL_IF_OBJ_NOT_EXISTS(jMeshopt, "byteLength", compression.ByteLength, "Required 'byteLength' property of EXT_meshopt_compression is not present, though mandatory");
+        OCASI_FAIL_IF_OBJ_NOT_EXISTS(jMeshopt, "byteStride", compression.ByteStride, "Required 'byteStride' property of EXT_meshopt_compression is not present, though mandatory");
+        OCASI_FAIL_IF_OBJ_NOT_EXISTS(jMeshopt, "count", compression.Count, "Required 'count' property of EXT_meshopt_compression is not present, though mandatory");
+        error_code byteOffsetError = jMeshopt["byteOffset"].get(compression.ByteOffset);
+        if (byteOffsetError && byteOffsetError != NO_SUCH_FIELD)
+            throw FailedImportError("The 'byteOffset' property of EXT_meshopt_compression has to be an integer");
+
+        std::string_view mode;
+        OCASI_FAIL_IF_OBJ_NOT_EXISTS(jMeshopt, "mode", mode, "Required 'mode' property of EXT_meshopt_compression is not present, though mandatory");
+        if (mode == "ATTRIBUTES")
+            compression.Mode = MeshoptMode::Attributes;
+        else if (mode == "TRIANGLES")
+            compression.Mode = MeshoptMode::Triangles;
+        else if (mode == "INDICES")
+            compression.Mode = MeshoptMode::Indices;
+        else
+            throw FailedImportError(FORMAT("Unknown EXT_meshopt_compression mode '{}'", mode));
+
+        std::string_view filter;
+        OCASI_HAS_PROPERTY(jMeshopt, "filter", filter)
+        {
+            if (filter == "NONE")
+                compression.Filter = MeshoptFilter::None;
+            else if (filter == "OCTAHEDRAL")
+                compression.Filter = MeshoptFilter::Octahedral;
+            else if (filter == "QUATERNION")
+                compression.Filter = MeshoptFilter::Quaternion;
+            else if (filter == "EXPONENTIAL")
+                compression.Filter = MeshoptFilter::Exponential;
+            else
+                throw FailedImportError(FORMAT("Unknown EXT_meshopt_compression filter '{}'", filter));
+        }
+    }
+
+    void JsonParser::ParseAccessors(simdjson::dom::array& jAccessors)
+    {
+        m_Asset->Accessors.reserve(jAccessors.size());
+
         size_t i = 0;
-        for (auto jAccessor : jAccessors)
+        for (auto rJAccessor : jAccessors)
         {
+            dom::object jAccessor;
+            OCASI_FAIL_ON_SIMDJSON_ERROR(rJAccessor.get(jAccessor), "Failed to get accessor");
             Accessor& accessor = m_Asset->Accessors.emplace_back(i);
-            
-            OCASI_FAIL_IF_OBJ_NOT_EXISTS(jAccessor, "count", accessor.ElementCount, "Required 'byteLength' property in accessor is not present, though mandatory");
-            std::string_view dataType;
-            OCASI_FAIL_IF_OBJ_NOT_EXISTS(jAccessor, "type", dataType, "Required 'type' property in accessor is not present, though mandatory");
-            size_t compType;
-            OCASI_FAIL_IF_OBJ_NOT_EXISTS(jAccessor, "componentType", compType, "Required 'componentType' property in accessor is not present, though mandatory");
-
-            accessor.CompType = (ComponentType) compType;
 
-            // Reading the data type
+            for (auto [key, value] : jAccessor)
             {
-                if (dataType == "SCALAR")
-                    accessor.Type = DataType::Scalar;
-                else if (dataType == "VEC2")
-                    accessor.Type = DataType::Vec2;
-                else if (dataType == "VEC3")
-                    accessor.Type = DataType::Vec3;
-                else if (dataType == "VEC4")
-                    accessor.Type = DataType::Vec4;
-                else if (dataType == "MAT2")
-                    accessor.Type = DataType::Mat2;
-                else if (dataType == "MAT3")
-                    accessor.Type = DataType::Mat3;
-                else if (dataType == "MAT4")
-                    accessor.Type = DataType::Mat4;
-                else
+                switch (HashKey(key))
                 {
-                    throw FailedImportError(FORMAT("Unsupported accessor data type {}", dataType));
-                }
-            }
-            
-            OCASI_SET_PROPERTY_IF_EXISTS(jAccessor, "bufferView", accessor.BufferView);
-            OCASI_SET_PROPERTY_IF_EXISTS(jAccessor, "byteOffset", accessor.ByteOffset);
-            OCASI_SET_PROPERTY_IF_EXISTS(jAccessor, "normalized", accessor.Normalized);
+                    OCASI_CASE_KEY("count")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(accessor.ElementCount), "The 'count' property of an accessor has to be an integer");
+                        break;
+                    OCASI_CASE_KEY("type")
+                    {
+                        std::string_view dataType;
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(dataType), "The 'type' property of an accessor has to be a string");
+                        accessor.Type = ParseDataType(dataType);
+                        break;
+                    }
+                    OCASI_CASE_KEY("componentType")
+                    {
+                        size_t compType;
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(compType), "The 'componentType' property of an accessor has to be an integer");
+                        accessor.CompType = (ComponentType) compType;
+                        break;
+                    }
+                    OCASI_CASE_KEY("bufferView")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(accessor.BufferView), "The 'bufferView' property of an accessor has to be an index");
+                        break;
+                    OCASI_CASE_KEY("byteOffset")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(accessor.ByteOffset), "The 'byteOffset' property of an accessor has to be an integer");
+                        break;
+                    OCASI_CASE_KEY("normalized")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(accessor.Normalized), "The 'normalized' property of an accessor has to be a boolean");
+                        break;
+                    OCASI_CASE_KEY("max")
+                    {
+                        dom::array jMax;
+                        if (value.get(jMax))
+                            break;
 
-            ondemand::array jMax;
-            OCASI_HAS_PROPERTY(jAccessor, "max", jMax)
-            {
-                size_t j = 0;
-                for (auto jMaxVal : jMax)
-                {
-                    OCASI_FAIL_ON_SIMDJSON_ERROR(jMaxVal.get(accessor.MaxValues.at(j)), "Failed to get 'max' property value.");
-                    j++;
-                }
-            }
-            
-            ondemand::array jMin;
-            OCASI_HAS_PROPERTY(jAccessor, "min", jMin)
-            {
-                size_t j = 0;
-                for (auto jMinVal : jMin)
-                {
-                    OCASI_FAIL_ON_SIMDJSON_ERROR(jMinVal.get(accessor.MinValues.at(j)), "Failed to get 'min' property value.");
-                    j++;
+                        size_t j = 0;
+                        for (auto jMaxVal : jMax)
+                        {
+                            OCASI_FAIL_ON_SIMDJSON_ERROR(jMaxVal.get(accessor.MaxValues.at(j)), "Failed to get 'max' property value.");
+                            j++;
+                        }
+                        break;
+                    }
+                    OCASI_CASE_KEY("min")
+                    {
+                        dom::array jMin;
+                        if (value.get(jMin))
+                            break;
+
+                        size_t j = 0;
+                        for (auto jMinVal : jMin)
+                        {
+                            OCASI_FAIL_ON_SIMDJSON_ERROR(jMinVal.get(accessor.MinValues.at(j)), "Failed to get 'min' property value.");
+                            j++;
+                        }
+                        break;
+                    }
+                    OCASI_CASE_KEY("sparse")
+                    {
+                        dom::object jSparse;
+                        if (!value.get(jSparse))
+                            ParseSparseAccessor(jSparse, accessor.SparseAccessor = Sparse());
+                        break;
+                    }
                 }
             }
-            
-            ondemand::object jSparse;
-            OCASI_HAS_PROPERTY(jAccessor, "sparse", jSparse)
-                ParseSparseAccessor(jSparse, accessor.SparseAccessor = Sparse());
-            
+
+            if (accessor.ElementCount == INVALID_ID)
+                throw FailedImportError("Required 'count' property in accessor is not present, though mandatory");
+            if (accessor.Type == DataType::None)
+                throw FailedImportError("Required 'type' property in accessor is not present, though mandatory");
+            if (accessor.CompType == ComponentType::None)
+                throw FailedImportError("Required 'componentType' property in accessor is not present, though mandatory");
             i++;
         }
     }
+
+    DataType JsonParser::ParseDataType(std::string_view dataType)
+    {
+        if (dataType == "SCALAR")
+            return DataType::Scalar;
+        else if (dataType == "VEC2")
+            return DataType::Vec2;
+        else if (dataType == "VEC3")
+            return DataType::Vec3;
+        else if (dataType == "VEC4")
+            return DataType::Vec4;
+        else if (dataType == "MAT2")
+            return DataType::Mat2;
+        else if (dataType == "MAT3")
+            return DataType::Mat3;
+        else if (dataType == "MAT4")
+            return DataType::Mat4;
+
+        throw FailedImportError(FORMAT("Unsupported accessor data type {}", dataType));
+    }
     
-    void JsonParser::ParseSparseAccessor(simdjson::ondemand::object& jSparse, std::optional<Sparse>& outSparse)
+    void JsonParser::ParseSparseAccessor(simdjson::dom::object& jSparse, std::optional<Sparse>& outSparse)
     {
-        auto& json = m_Json->Get();
-        
         OCASI_FAIL_IF_OBJ_NOT_EXISTS(jSparse, "count", outSparse->ElementCount, "Required 'count' property in sparse accessor is not present, though mandatory.");
-        ondemand::object jSparseIndices;
+        dom::object jSparseIndices;
         OCASI_FAIL_IF_OBJ_NOT_EXISTS(jSparse, "indices", jSparseIndices, "Required 'indices' property in sparse accessor is not present, though mandatory.");
-        ondemand::object jSparseValues;
+        dom::object jSparseValues;
         OCASI_FAIL_IF_OBJ_NOT_EXISTS(jSparse, "values", jSparseValues, "Required 'values' property in sparse accessor is not present, though mandatory.");
         
         // Indices
@@ -292,369 +540,555 @@ namespace OCASI::GLTF {
             OCASI_FAIL_IF_OBJ_NOT_EXISTS(jSparseIndices, "bufferView", outSparse->Indices.BufferView, "Required 'bufferView' property in sparse accessor indices is not present, though mandatory.")
             size_t compType;
             OCASI_FAIL_IF_OBJ_NOT_EXISTS(jSparseIndices, "componentType", compType, "Required 'componentType' property in sparse accessor indices is not present, though mandatory.")
+            outSparse->Indices.CompType = (ComponentType) compType;
             
-            OCASI_SET_PROPERTY_IF_EXISTS(jSparseIndices, "byteOffset", outSparse->Indices.ByteOffset);
+            error_code byteOffsetError = jSparseIndices["byteOffset"].get(outSparse->Indices.ByteOffset);
+            if (byteOffsetError && byteOffsetError != NO_SUCH_FIELD)
+                throw FailedImportError("The 'byteOffset' property of sparse accessor indices has to be an integer");
         }
         
         // Values
         {
             OCASI_FAIL_IF_OBJ_NOT_EXISTS(jSparseValues, "bufferView", outSparse->Values.BufferView, "Required 'bufferView' property in sparse accessor values is not present, though mandatory.")
-            OCASI_SET_PROPERTY_IF_EXISTS(jSparseValues, "byteOffset", outSparse->Values.ByteOffset);
+            error_code byteOffsetError = jSparseValues["byteOffset"].get(outSparse->Values.ByteOffset);
+            if (byteOffsetError && byteOffsetError != NO_SUCH_FIELD)
+                throw FailedImportError("The 'byteOffset' property of sparse accessor values has to be an integer");
         }
     }
     
-    void JsonParser::ParseImages()
+    void JsonParser::ParseImages(simdjson::dom::array& jImages)
     {
-        auto& json = m_Json->Get();
-        
-        ondemand::array jImages;
-        if (json[IMAGES_PROPERTY].get(jImages))
-            return;
+        m_Asset->Images.reserve(jImages.size());
 
         size_t i = 0;
-        for (auto jImage : jImages)
+        for (auto rJImage : jImages)
         {
-            
+            dom::object jImage;
+            OCASI_FAIL_ON_SIMDJSON_ERROR(rJImage.get(jImage), "Failed to get image");
             Image& image = m_Asset->Images.emplace_back(i);
-            
-            std::string_view val;
-            OCASI_SET_PROPERTY_IF_EXISTS(jImage, "uri", val);
-            image.URI = val;
-            OCASI_SET_PROPERTY_IF_EXISTS(jImage, "mimeType", val);
-            image.MimeType = val;
-            OCASI_SET_PROPERTY_IF_EXISTS(jImage, "bufferView", image.BufferView);
+
+            for (auto [key, value] : jImage)
+            {
+                switch (HashKey(key))
+                {
+                    OCASI_CASE_KEY("uri")
+                    {
+                        std::string_view uri;
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(uri), "The 'uri' property of an image has to be a string");
+                        image.URI = uri;
+                        break;
+                    }
+                    OCASI_CASE_KEY("mimeType")
+                    {
+                        std::string_view mimeType;
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(mimeType), "The 'mimeType' property of an image has to be a string");
+                        image.MimeType = mimeType;
+                        break;
+                    }
+                    OCASI_CASE_KEY("bufferView")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(image.BufferView), "The 'bufferView' property of an image has to be an index");
+                        break;
+                }
+            }
             i++;
         }
     }
     
-    void JsonParser::ParseSamplers()
+    void JsonParser::ParseSamplers(simdjson::dom::array& jSamplers)
     {
-        auto& json = m_Json->Get();
-        
-        ondemand::array jSamplers;
-        if (json[SAMPLERS_PROPERTY].get(jSamplers))
-            return;
-        
+        m_Asset->Samplers.reserve(jSamplers.size());
+
         size_t i = 0;
-        for (auto jSampler : jSamplers)
+        for (auto rJSampler : jSamplers)
         {
+            dom::object jSampler;
+            OCASI_FAIL_ON_SIMDJSON_ERROR(rJSampler.get(jSampler), "Failed to get sampler");
             Sampler& sampler = m_Asset->Samplers.emplace_back(i);
-            
-            size_t val = 0;
-            OCASI_SET_PROPERTY_IF_EXISTS(jSampler, "magFilter", val);
-            sampler.MagFilter = (MinMagFilter) val;
-            OCASI_SET_PROPERTY_IF_EXISTS(jSampler, "minFilter", val);
-            sampler.MinFilter = (MinMagFilter) val;
-            
-            OCASI_SET_PROPERTY_IF_EXISTS(jSampler, "wrapS", val);
-            sampler.WrapS = (UVWrap) val;
-            OCASI_SET_PROPERTY_IF_EXISTS(jSampler, "wrapT", val);
-            sampler.WrapT = (UVWrap) val;
+
+            for (auto [key, value] : jSampler)
+            {
+                size_t val = 0;
+                switch (HashKey(key))
+                {
+                    OCASI_CASE_KEY("magFilter")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(val), "The 'magFilter' property of a sampler has to be an integer");
+                        sampler.MagFilter = (MinMagFilter) val;
+                        break;
+                    OCASI_CASE_KEY("minFilter")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(val), "The 'minFilter' property of a sampler has to be an integer");
+                        sampler.MinFilter = (MinMagFilter) val;
+                        break;
+                    OCASI_CASE_KEY("wrapS")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(val), "The 'wrapS' property of a sampler has to be an integer");
+                        sampler.WrapS = (UVWrap) val;
+                        break;
+                    OCASI_CASE_KEY("wrapT")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(val), "The 'wrapT' property of a sampler has to be an integer");
+                        sampler.WrapT = (UVWrap) val;
+                        break;
+                }
+            }
             i++;
         }
     }
     
-    void JsonParser::ParseTextures()
+    void JsonParser::ParseTextures(simdjson::dom::array& jTextures)
     {
-        auto& json = m_Json->Get();
-        
-        ondemand::array jTextures;
-        if (json[TEXTURES_PROPERTY].get(jTextures))
-            return;
-        
+        m_Asset->Textures.reserve(jTextures.size());
+
         size_t i = 0;
-        for (auto jTexture : jTextures)
+        for (auto rJTexture : jTextures)
         {
-            
+            dom::object jTexture;
+            OCASI_FAIL_ON_SIMDJSON_ERROR(rJTexture.get(jTexture), "Failed to get texture");
             Texture& texture = m_Asset->Textures.emplace_back(i);
-            OCASI_SET_PROPERTY_IF_EXISTS(jTexture, "source", texture.Source);
-            OCASI_SET_PROPERTY_IF_EXISTS(jTexture, "sampler", texture.Sampler);
+
+            for (auto [key, value] : jTexture)
+            {
+                switch (HashKey(key))
+                {
+                    OCASI_CASE_KEY("source")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(texture.Source), "The 'source' property of a texture has to be an index");
+                        break;
+                    OCASI_CASE_KEY("sampler")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(texture.Sampler), "The 'sampler' property of a texture has to be an index");
+                        break;
+                }
+            }
             i++;
         }
     }
     
-    void JsonParser::ParseTextureInfo(simdjson::fallback::ondemand::object& jObject, std::string_view name, std::optional<TextureInfo>& outTextureInfo)
+    void JsonParser::ParseTextureInfo(simdjson::dom::object& jObject, std::string_view name, std::optional<TextureInfo>& outTextureInfo)
     {
-        ondemand::object jTextureInfo;
+        dom::element jTextureInfo;
         OCASI_HAS_PROPERTY(jObject, name, jTextureInfo)
+            ParseTextureInfo(jTextureInfo, outTextureInfo);
+    }
+
+    void JsonParser::ParseTextureInfo(const simdjson::dom::element& jElement, std::optional<TextureInfo>& outTextureInfo)
+    {
+        dom::object jTextureInfo;
+        if (jElement.get(jTextureInfo))
+            return;
+
+        outTextureInfo = TextureInfo();
+
+        for (auto [key, value] : jTextureInfo)
         {
-            outTextureInfo = TextureInfo();
-            
-            OCASI_FAIL_IF_OBJ_NOT_EXISTS(jTextureInfo, "index", outTextureInfo->Texture, "Required 'index' property in texture info is not present, though mandatory");
-            
-            OCASI_SET_PROPERTY_IF_EXISTS(jTextureInfo, "texCoord", outTextureInfo->TexCoords);
-            OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jTextureInfo, "scale", float, outTextureInfo->Scale);
-            OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jTextureInfo, "strength", float, outTextureInfo->Scale);
+            switch (HashKey(key))
+            {
+                OCASI_CASE_KEY("index")
+                    OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(outTextureInfo->Texture), "The 'index' property of a texture info has to be an index");
+                    break;
+                OCASI_CASE_KEY("texCoord")
+                    OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(outTextureInfo->TexCoords), "The 'texCoord' property of a texture info has to be an integer");
+                    break;
+                // Normal textures have a scale, occlusion textures a strength
+                OCASI_CASE_KEY("scale")
+                    OCASI_FAIL_ON_SIMDJSON_ERROR(GetFloat(value, outTextureInfo->Scale), "The 'scale' property of a normal texture info has to be a number");
+                    break;
+                OCASI_CASE_KEY("strength")
+                    OCASI_FAIL_ON_SIMDJSON_ERROR(GetFloat(value, outTextureInfo->Scale), "The 'strength' property of an occlusion texture info has to be a number");
+                    break;
+            }
         }
-        
-        return;
+
+        if (outTextureInfo->Texture == INVALID_ID)
+            throw FailedImportError("Required 'index' property in texture info is not present, though mandatory");
     }
     
-    void JsonParser::ParseMaterials()
+    void JsonParser::ParseMaterials(simdjson::dom::array& jMaterials)
     {
-        auto& json = m_Json->Get();
-        
-        ondemand::array jMaterials;
-        if (json[MATERIALS_PROPERTY].get(jMaterials))
-            return;
-        
+        m_Asset->Materials.reserve(jMaterials.size());
+
         size_t i = 0;
         for (auto rJMaterial : jMaterials)
         {
-            ondemand::object jMaterial;
+            dom::object jMaterial;
             OCASI_FAIL_ON_SIMDJSON_ERROR(rJMaterial.get(jMaterial), "Failed to get texture object");
             Material& material = m_Asset->Materials.emplace_back(i);
-            
-            std::string_view name;
-            OCASI_SET_PROPERTY_IF_EXISTS(jMaterial, "name", name);
-            material.Name = name;
-            
-            ondemand::object jPbrMetallicRoughness;
-            OCASI_HAS_PROPERTY(jMaterial, "pbrMetallicRoughness", jPbrMetallicRoughness)
-                ParsePbrMetallicRoughness(jPbrMetallicRoughness, material.MetallicRoughness = PBRMetallicRoughness());
-            
-            ParseTextureInfo(jMaterial, "normalTexture", material.NormalTexture);
-            ParseTextureInfo(jMaterial, "occlusionTexture", material.OcclusionTexture);
-            ParseTextureInfo(jMaterial, "emissiveTexture", material.EmissiveTexture);
-            ParseVec3(jMaterial, "emissiveFactor", material.EmissiveColour);
-            
-            std::string_view alphaMode;
-            OCASI_HAS_PROPERTY(jMaterial, "alphaMode", alphaMode)
+
+            for (auto [key, value] : jMaterial)
             {
-                if (alphaMode == "OPAQUE")
-                    material.AMode = AlphaMode::Opaque;
-                else if (alphaMode == "MASK")
-                    material.AMode = AlphaMode::Mask;
-                else if (alphaMode == "BLEND")
-                    material.AMode = AlphaMode::Blend;
-                else
+                switch (HashKey(key))
                 {
-                    throw FailedImportError(FORMAT("Unsupported alphaMode option {}.", alphaMode));
+                    OCASI_CASE_KEY("name")
+                    {
+                        std::string_view name;
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(name), "The 'name' property of a material has to be a string");
+                        material.Name = name;
+                        break;
+                    }
+                    OCASI_CASE_KEY("pbrMetallicRoughness")
+                    {
+                        dom::object jPbrMetallicRoughness;
+                        if (!value.get(jPbrMetallicRoughness))
+                            ParsePbrMetallicRoughness(jPbrMetallicRoughness, material.MetallicRoughness = PBRMetallicRoughness());
+                        break;
+                    }
+                    OCASI_CASE_KEY("normalTexture")
+                        ParseTextureInfo(value, material.NormalTexture);
+                        break;
+                    OCASI_CASE_KEY("occlusionTexture")
+                        ParseTextureInfo(value, material.OcclusionTexture);
+                        break;
+                    OCASI_CASE_KEY("emissiveTexture")
+                        ParseTextureInfo(value, material.EmissiveTexture);
+                        break;
+                    OCASI_CASE_KEY("emissiveFactor")
+                        ParseVec3(value, material.EmissiveColour);
+                        break;
+                    OCASI_CASE_KEY("alphaMode")
+                    {
+                        std::string_view alphaMode;
+                        if (value.get(alphaMode))
+                            break;
+
+                        if (alphaMode == "OPAQUE")
+                            material.AMode = AlphaMode::Opaque;
+                        else if (alphaMode == "MASK")
+                            material.AMode = AlphaMode::Mask;
+                        else if (alphaMode == "BLEND")
+                            material.AMode = AlphaMode::Blend;
+                        else
+                        {
+                            throw FailedImportError(FORMAT("Unsupported alphaMode option {}.", alphaMode));
+                        }
+                        break;
+                    }
+                    OCASI_CASE_KEY("alphaCutoff")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(GetFloat(value, material.AlphaCutoff), "The 'alphaCutoff' property of a material has to be a number");
+                        break;
+                    OCASI_CASE_KEY("doubleSided")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(material.IsDoubleSided), "The 'doubleSided' property of a material has to be a boolean");
+                        break;
+                    OCASI_CASE_KEY("extensions")
+                    {
+                        dom::object jExtensions;
+                        if (!value.get(jExtensions))
+                            ParseMaterialExtensions(jExtensions, material);
+                        break;
+                    }
                 }
             }
-            
-            auto t  = jMaterial.at_path("").get<float>();
-            
-            OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jMaterial, "alphaCutoff", float, material.AlphaCutoff);
-            OCASI_SET_PROPERTY_IF_EXISTS(jMaterial, "doubleSided", material.IsDoubleSided);
-            
-            /// Extensions
-            ondemand::array jExtensions;
-            OCASI_HAS_PROPERTY(jMaterial, "extensions", jExtensions)
+            i++;
+        }
+    }
+
+    void JsonParser::ParseMaterialExtensions(simdjson::dom::object& jExtensions, Material& material)
+    {
+        // The extensions object maps the extension names to the extension objects
+        for (auto [key, value] : jExtensions)
+        {
+            dom::object jExt;
+            if (value.get(jExt))
+                continue;
+
+            switch (HashKey(key))
             {
-                size_t j = 0;
-                for (auto rJExt : jExtensions)
-                {
-                    ondemand::object jExt;
-                    OCASI_FAIL_ON_SIMDJSON_ERROR(jExtensions.at(i).get(jExt), "Failed to get extension");
-                    
-                    OCASI_HAS_PROPERTY(jMaterial, "KHR_materials_pbrSpecularGlossiness", jExt)
-                        ParsePbrSpecularGlossiness(jExt, material.ExtSpecularGlossiness = KHRMaterialPbrSpecularGlossiness());
-                    
-                    OCASI_HAS_PROPERTY(jMaterial, "KHR_materials_specular", jExt)
-                        ParseSpecular(jExt, material.ExtSpecular = KHRMaterialSpecular());
-                    
-                    OCASI_HAS_PROPERTY(jMaterial, "KHR_materials_clearcoat", jExt)
-                        ParseClearcoat(jExt, material.ExtClearcoat = KHRMaterialClearcoat());
-                    
-                    OCASI_HAS_PROPERTY(jMaterial, "KHR_materials_sheen", jExt)
-                        ParseSheen(jExt, material.ExtSheen = KHRMaterialSheen());
-                    
-                    OCASI_HAS_PROPERTY(jMaterial, "KHR_materials_transmission", jExt)
-                        ParseTransmission(jExt, material.ExtTransmission = KHRMaterialTransmission());
-                    
-                    OCASI_HAS_PROPERTY(jMaterial, "KHR_materials_volume", jExt)
-                        ParseVolume(jExt, material.ExtVolume = KHRMaterialVolume());
-                    
-                    OCASI_HAS_PROPERTY(jMaterial, "KHR_materials_ior", jExt)
-                        ParseIOR(jExt, material.ExtIOR = KHRMaterialIOR());
-                    
-                    OCASI_HAS_PROPERTY(jMaterial, "KHR_materials_emissive_strength", jExt)
-                        ParseEmissiveStrength(jExt, material.ExtEmissiveStrength = KHRMaterialEmissiveStrength());
-                    
-                    OCASI_HAS_PROPERTY(jMaterial, "KHR_materials_iridescence", jExt)
-                        ParseIridescence(jExt, material.ExtIridescence = KHRMaterialIridescence());
-                    
-                    OCASI_HAS_PROPERTY(jMaterial, "KHR_materials_anisotropy", jExt)
-                        ParseAnisotropy(jExt, material.ExtAnisotropy = KHRMaterialAnisotropy());
-                    j++;
-                }
+                OCASI_CASE_KEY("KHR_materials_pbrSpecularGlossiness")
+                    ParsePbrSpecularGlossiness(jExt, material.ExtSpecularGlossiness = KHRMaterialPbrSpecularGlossiness());
+                    break;
+                OCASI_CASE_KEY("KHR_materials_specular")
+                    ParseSpecular(jExt, material.ExtSpecular = KHRMaterialSpecular());
+                    break;
+                OCASI_CASE_KEY("KHR_materials_clearcoat")
+                    ParseClearcoat(jExt, material.ExtClearcoat = KHRMaterialClearcoat());
+                    break;
+                OCASI_CASE_KEY("KHR_materials_sheen")
+                    ParseSheen(jExt, material.ExtSheen = KHRMaterialSheen());
+                    break;
+                OCASI_CASE_KEY("KHR_materials_transmission")
+                    ParseTransmission(jExt, material.ExtTransmission = KHRMaterialTransmission());
+                    break;
+                OCASI_CASE_KEY("KHR_materials_volume")
+                    ParseVolume(jExt, material.ExtVolume = KHRMaterialVolume());
+                    break;
+                OCASI_CASE_KEY("KHR_materials_ior")
+                    ParseIOR(jExt, material.ExtIOR = KHRMaterialIOR());
+                    break;
+                OCASI_CASE_KEY("KHR_materials_emissive_strength")
+                    ParseEmissiveStrength(jExt, material.ExtEmissiveStrength = KHRMaterialEmissiveStrength());
+                    break;
+                OCASI_CASE_KEY("KHR_materials_iridescence")
+                    ParseIridescence(jExt, material.ExtIridescence = KHRMaterialIridescence());
+                    break;
+                OCASI_CASE_KEY("KHR_materials_anisotropy")
+                    ParseAnisotropy(jExt, material.ExtAnisotropy = KHRMaterialAnisotropy());
+                    break;
             }
-            i++;
         }
     }
     
-    void JsonParser::ParseMeshes()
+    void JsonParser::ParseMeshes(simdjson::dom::array& jMeshes)
     {
-        auto& json = m_Json->Get();
-        
-        ondemand::array jMeshes;
-        if (json[MESHES_PROPERTY].get(jMeshes))
-            return;
+        m_Asset->Meshes.reserve(jMeshes.size());
 
         size_t i = 0;
-        for (auto jMesh : jMeshes)
+        for (auto rJMesh : jMeshes)
         {
+            dom::object jMesh;
+            OCASI_FAIL_ON_SIMDJSON_ERROR(rJMesh.get(jMesh), "Failed to get mesh");
             Mesh& mesh = m_Asset->Meshes.emplace_back(i);
-            
-            ondemand::array jPrimitives;
-            OCASI_FAIL_IF_OBJ_NOT_EXISTS(jMesh, "primitives", jPrimitives, "Required 'primitives' property in mesh is not present, though mandatory");
-            
-            ParsePrimitives(jPrimitives, mesh);
-            
-            ondemand::array jWeights;
-            OCASI_HAS_PROPERTY(jMesh, "weights", jWeights)
+            bool hasPrimitives = false;
+
+            for (auto [key, value] : jMesh)
             {
-                for (auto jWeight : jWeights)
+                switch (HashKey(key))
                 {
-                    OCASI_FAIL_ON_SIMDJSON_ERROR(jWeight.get<float>().get(mesh.Weights.emplace_back()), "Failed to get mesh weight");
+                    OCASI_CASE_KEY("primitives")
+                    {
+                        dom::array jPrimitives;
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(jPrimitives), "The 'primitives' property of a mesh has to be an array");
+                        ParsePrimitives(jPrimitives, mesh);
+                        hasPrimitives = true;
+                        break;
+                    }
+                    OCASI_CASE_KEY("weights")
+                    {
+                        dom::array jWeights;
+                        if (value.get(jWeights))
+                            break;
+
+                        for (auto jWeight : jWeights)
+                        {
+                            OCASI_FAIL_ON_SIMDJSON_ERROR(GetFloat(jWeight, mesh.Weights.emplace_back()), "Failed to get mesh weight");
+                        }
+                        break;
+                    }
                 }
             }
+
+            if (!hasPrimitives)
+                throw FailedImportError("Required 'primitives' property in mesh is not present, though mandatory");
             i++;
         }
     }
     
-    void JsonParser::ParsePrimitives(simdjson::fallback::ondemand::array& jPrimitives, Mesh& mesh)
+    void JsonParser::ParsePrimitives(simdjson::dom::array& jPrimitives, Mesh& mesh)
     {
+        mesh.Primitives.reserve(jPrimitives.size());
+
         size_t i = 0;
-        for (auto jPrimitive : jPrimitives)
+        for (auto rJPrimitive : jPrimitives)
         {
+            dom::object jPrimitive;
+            OCASI_FAIL_ON_SIMDJSON_ERROR(rJPrimitive.get(jPrimitive), "Failed to get mesh primitive");
             Primitive& primitive = mesh.Primitives.emplace_back(i);
-            
-            ondemand::object jAttributes;
-            OCASI_FAIL_IF_OBJ_NOT_EXISTS(jPrimitive, "attributes", jAttributes, "Required 'primitives' property in mesh primitive is not present, though mandatory");
-            ParseVertexAttributes(jAttributes, primitive.Attributes);
-            
-            OCASI_SET_PROPERTY_IF_EXISTS(jPrimitive, "indices", primitive.Indices);
-            OCASI_SET_PROPERTY_IF_EXISTS(jPrimitive, "material", primitive.MaterialIndex);
-            size_t mode = 0;
-            OCASI_HAS_PROPERTY(jPrimitive, "mode", mode)
-            {
-                primitive.Type = (PrimitiveType) mode;
-            }
-            
-            ondemand::array jTargets;
-            OCASI_HAS_PROPERTY(jPrimitive, "targets", jTargets)
+            bool hasAttributes = false;
+
+            for (auto [key, value] : jPrimitive)
             {
-                size_t j = 0;
-                for (auto rJTarget : jTargets)
+                switch (HashKey(key))
                 {
-                    ondemand::object jTarget;
-                    OCASI_FAIL_ON_SIMDJSON_ERROR(rJTarget.get(jTarget), "Failed to get morph target");
-                    ParseVertexAttributes(jTarget, primitive.MorphTargets.emplace_back(j));
-                    j++;
+                    OCASI_CASE_KEY("attributes")
+                    {
+                        dom::object jAttributes;
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(jAttributes), "The 'attributes' property of a mesh primitive has to be an object");
+                        ParseVertexAttributes(jAttributes, primitive.Attributes);
+                        hasAttributes = true;
+                        break;
+                    }
+                    OCASI_CASE_KEY("indices")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(primitive.Indices), "The 'indices' property of a primitive has to be an index");
+                        break;
+                    OCASI_CASE_KEY("material")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(primitive.MaterialIndex), "The 'material' property of a primitive has to be an index");
+                        break;
+                    OCASI_CASE_KEY("mode")
+                    {
+                        size_t mode;
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(mode), "The 'mode' property of a primitive has to be an integer");
+                        primitive.Type = (PrimitiveType) mode;
+                        break;
+                    }
+                    OCASI_CASE_KEY("targets")
+                    {
+                        dom::array jTargets;
+                        if (value.get(jTargets))
+                            break;
+
+                        size_t j = 0;
+                        for (auto rJTarget : jTargets)
+                        {
+                            dom::object jTarget;
+                            OCASI_FAIL_ON_SIMDJSON_ERROR(rJTarget.get(jTarget), "Failed to get morph target");
+                            ParseVertexAttributes(jTarget, primitive.MorphTargets.emplace_back(j));
+                            j++;
+                        }
+                        break;
+                    }
+                    OCASI_CASE_KEY("extensions")
+                    {
+                        dom::object jDraco;
+                        if (!value["KHR_draco_mesh_compression"].get(jDraco))
+                            ParseDracoMeshCompression(jDraco, primitive.ExtDracoMeshCompression = KHRDracoMeshCompression());
+                        break;
+                    }
                 }
             }
+
+            if (!hasAttributes)
+                throw FailedImportError("Required 'attributes' property in mesh primitive is not present, though mandatory");
         }
     }
     
-    void JsonParser::ParseNodes()
+    void JsonParser::ParseNodes(simdjson::dom::array& jNodes)
     {
-        auto& json = m_Json->Get();
-        
-        ondemand::array jNodes;
-        if (json[NODES_PROPERTY].get(jNodes))
-            return;
+        m_Asset->Nodes.reserve(jNodes.size());
 
         size_t i = 0;
         for (auto rJNode : jNodes)
         {
-            ondemand::object jNode;
+            dom::object jNode;
             OCASI_FAIL_ON_SIMDJSON_ERROR(rJNode.get(jNode), "Failed to get node");
             Node& node = m_Asset->Nodes.emplace_back(i);
 
             // Cameras and animations are not supported
-            ondemand::array jChildren;
-            OCASI_HAS_PROPERTY(jNode, "children", jChildren)
-            {
-                for (auto jChild : jChildren)
-                {
-                    OCASI_FAIL_ON_SIMDJSON_ERROR(jChild.get(node.Children.emplace_back()), "Failed to get node child")
-                }
-            }
-            
-            std::string_view name;
-            OCASI_SET_PROPERTY_IF_EXISTS(jNode, "name", name);
-            node.Name = name;
-            
-            OCASI_SET_PROPERTY_IF_EXISTS(jNode, "mesh", node.Mesh);
-            
-            ParseVec3(jNode, "translation", node.TrsComponent.Translation);
-            glm::vec4 rotVec;
-            ParseVec4(jNode, "rotation", rotVec);
-            node.TrsComponent.Rotation = glm::quat(rotVec.w, rotVec.x, rotVec.y, rotVec.z);
-            ParseVec3(jNode, "scale", node.TrsComponent.Scale);
-            
-            ondemand::array jMatrix;
-            OCASI_HAS_PROPERTY(jNode, "matrix", jMatrix)
+            for (auto [key, value] : jNode)
             {
-                size_t j = 0;
-                for (auto jMatrixVal : jMatrix)
+                switch (HashKey(key))
                 {
-                    OCASI_FAIL_ON_SIMDJSON_ERROR(jMatrixVal.get<float>().get(node.LocalTranslationMatrix[j % 4][j / 4]), "Failed to get matrix value");
-                    j++;
-                }
-                
-                OCASI_ASSERT(j == 16);
-            }
-            
-            ondemand::array jWeights;
-            OCASI_HAS_PROPERTY(jNode, "weights", jMatrix)
-            {
-                for (auto jWeight : jWeights)
-                {
-                    OCASI_FAIL_ON_SIMDJSON_ERROR(jWeight.get<float>().get(node.Weights.emplace_back()), "Failed to get matrix value");
+                    OCASI_CASE_KEY("children")
+                    {
+                        dom::array jChildren;
+                        if (value.get(jChildren))
+                            break;
+
+                        node.Children.reserve(jChildren.size());
+                        for (auto jChild : jChildren)
+                        {
+                            OCASI_FAIL_ON_SIMDJSON_ERROR(jChild.get(node.Children.emplace_back()), "Failed to get node child")
+                        }
+                        break;
+                    }
+                    OCASI_CASE_KEY("name")
+                    {
+                        std::string_view name;
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(name), "The 'name' property of a node has to be a string");
+                        node.Name = name;
+                        break;
+                    }
+                    OCASI_CASE_KEY("mesh")
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(node.Mesh), "The 'mesh' property of a node has to be an index");
+                        break;
+                    OCASI_CASE_KEY("translation")
+                        ParseVec3(value, node.TrsComponent.Translation);
+                        break;
+                    OCASI_CASE_KEY("rotation")
+                    {
+                        // glTF stores quaternions as (x, y, z, w)
+                        glm::vec4 rotVec(0.0f, 0.0f, 0.0f, 1.0f);
+                        ParseVec4(value, rotVec);
+                        node.TrsComponent.Rotation = glm::quat(rotVec.w, rotVec.x, rotVec.y, rotVec.z);
+                        break;
+                    }
+                    OCASI_CASE_KEY("scale")
+                        ParseVec3(value, node.TrsComponent.Scale);
+                        break;
+                    OCASI_CASE_KEY("matrix")
+                    {
+                        dom::array jMatrix;
+                        if (value.get(jMatrix))
+                            break;
+
+                        size_t j = 0;
+                        for (auto jMatrixVal : jMatrix)
+                        {
+                            OCASI_FAIL_ON_SIMDJSON_ERROR(GetFloat(jMatrixVal, node.LocalTranslationMatrix[j % 4][j / 4]), "Failed to get matrix value");
+                            j++;
+                        }
+
+                        OCASI_ASSERT(j == 16);
+                        break;
+                    }
+                    OCASI_CASE_KEY("weights")
+                    {
+                        dom::array jWeights;
+                        if (value.get(jWeights))
+                            break;
+
+                        for (auto jWeight : jWeights)
+                        {
+                            OCASI_FAIL_ON_SIMDJSON_ERROR(GetFloat(jWeight, node.Weights.emplace_back()), "Failed to get node weight");
+                        }
+                        break;
+                    }
                 }
             }
             i++;
         }
     }
     
-    void JsonParser::ParseScenes()
+    void JsonParser::ParseScenes(simdjson::dom::array& jScenes)
     {
-        auto& json = m_Json->Get();
-        
-        ondemand::array jScenes;
-        if (json[SCENES_PROPERTY].get(jScenes))
-            return;
+        m_Asset->Scenes.reserve(jScenes.size());
 
         size_t i = 0;
-        for (auto jScene : jScenes)
+        for (auto rJScene : jScenes)
         {
+            dom::object jScene;
+            OCASI_FAIL_ON_SIMDJSON_ERROR(rJScene.get(jScene), "Failed to get scene");
             Scene& scene = m_Asset->Scenes.emplace_back(i);
-            
-            std::string_view name;
-            OCASI_SET_PROPERTY_IF_EXISTS(jScene, "name", name);
-            scene.Name = name;
-            
-            ondemand::array jRootNodes;
-            OCASI_HAS_PROPERTY(jScene, "nodes", jRootNodes)
+
+            for (auto [key, value] : jScene)
             {
-                size_t j = 0;
-                for (auto jNode : jRootNodes)
+                switch (HashKey(key))
                 {
-                    OCASI_FAIL_ON_SIMDJSON_ERROR(jNode.get(scene.RootNodes.emplace_back()), "Failed to get root node");
-                    j++;
+                    OCASI_CASE_KEY("name")
+                    {
+                        std::string_view name;
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(name), "The 'name' property of a scene has to be a string");
+                        scene.Name = name;
+                        break;
+                    }
+                    OCASI_CASE_KEY("nodes")
+                    {
+                        dom::array jRootNodes;
+                        OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(jRootNodes), "The 'nodes' property of a scene has to be an array");
+
+                        scene.RootNodes.reserve(jRootNodes.size());
+                        for (auto jNode : jRootNodes)
+                        {
+                            OCASI_FAIL_ON_SIMDJSON_ERROR(jNode.get(scene.RootNodes.emplace_back()), "Failed to get root node");
+                        }
+                        break;
+                    }
                 }
             }
             i++;
         }
     }
     
-    void JsonParser::ParsePbrMetallicRoughness(simdjson::fallback::ondemand::object& jPbrMetallicRoughness, std::optional<PBRMetallicRoughness>& outMetallicRoughness)
+    void JsonParser::ParsePbrMetallicRoughness(simdjson::dom::object& jPbrMetallicRoughness, std::optional<PBRMetallicRoughness>& outMetallicRoughness)
     {
-        OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jPbrMetallicRoughness, "metallicFactor", float, outMetallicRoughness->Metallic);
-        OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jPbrMetallicRoughness, "roughnessFactor", float, outMetallicRoughness->Roughness);
-        
-        ParseVec4(jPbrMetallicRoughness, "baseColorFactor", outMetallicRoughness->BaseColour);
-        ParseTextureInfo(jPbrMetallicRoughness, "baseColorTexture", outMetallicRoughness->BaseColourTexture);
-        
-        ParseTextureInfo(jPbrMetallicRoughness, "metallicRoughnessTexture", outMetallicRoughness->MetallicRoughnessTexture);
+        for (auto [key, value] : jPbrMetallicRoughness)
+        {
+            switch (HashKey(key))
+            {
+                OCASI_CASE_KEY("metallicFactor")
+                    OCASI_FAIL_ON_SIMDJSON_ERROR(GetFloat(value, outMetallicRoughness->Metallic), "The 'metallicFactor' property of a material has to be a number");
+                    break;
+                OCASI_CASE_KEY("roughnessFactor")
+                    OCASI_FAIL_ON_SIMDJSON_ERROR(GetFloat(value, outMetallicRoughness->Roughness), "The 'roughnessFactor' property of a material has to be a number");
+                    break;
+                OCASI_CASE_KEY("baseColorFactor")
+                    ParseVec4(value, outMetallicRoughness->BaseColour);
+                    break;
+                OCASI_CASE_KEY("baseColorTexture")
+                    ParseTextureInfo(value, outMetallicRoughness->BaseColourTexture);
+                    break;
+                OCASI_CASE_KEY("metallicRoughnessTexture")
+                    ParseTextureInfo(value, outMetallicRoughness->MetallicRoughnessTexture);
+                    break;
+            }
+        }
     }
     
-    void JsonParser::ParsePbrSpecularGlossiness(simdjson::fallback::ondemand::object& jPbrSpecularGlossiness, std::optional<KHRMaterialPbrSpecularGlossiness> &outSpecularGlossiness)
+    void JsonParser::ParsePbrSpecularGlossiness(simdjson::dom::object& jPbrSpecularGlossiness, std::optional<KHRMaterialPbrSpecularGlossiness> &outSpecularGlossiness)
     {
-        OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jPbrSpecularGlossiness, "glossinessFactor", float, outSpecularGlossiness->GlossinessFactor);
+        OCASI_SET_FLOAT_PROPERTY_IF_EXISTS(jPbrSpecularGlossiness, "glossinessFactor", outSpecularGlossiness->GlossinessFactor);
         ParseTextureInfo(jPbrSpecularGlossiness, "specularGlossinessTexture", outSpecularGlossiness->SpecularGlossinessTexture);
         
         ParseVec4(jPbrSpecularGlossiness, "diffuseFactor", outSpecularGlossiness->DiffuseFactor);
@@ -663,9 +1097,9 @@ namespace OCASI::GLTF {
         ParseVec3(jPbrSpecularGlossiness, "specularFactor", outSpecularGlossiness->SpecularFactor);
     }
     
-    void JsonParser::ParseSpecular(simdjson::fallback::ondemand::object& jSpecular, std::optional<KHRMaterialSpecular> &outSpecular)
+    void JsonParser::ParseSpecular(simdjson::dom::object& jSpecular, std::optional<KHRMaterialSpecular> &outSpecular)
     {
-        OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jSpecular, "specularFactor", float, outSpecular->SpecularFactor);
+        OCASI_SET_FLOAT_PROPERTY_IF_EXISTS(jSpecular, "specularFactor", outSpecular->SpecularFactor);
         ParseTextureInfo(jSpecular, "specularTexture", outSpecular->SpecularTexture);
         
         ParseVec3(jSpecular, "specularColorFactor", outSpecular->SpecularColourFactor);
@@ -673,21 +1107,21 @@ namespace OCASI::GLTF {
         
     }
     
-    void JsonParser::ParseClearcoat(simdjson::fallback::ondemand::object& jClearCoat, std::optional<KHRMaterialClearcoat>& outClearcoat)
+    void JsonParser::ParseClearcoat(simdjson::dom::object& jClearCoat, std::optional<KHRMaterialClearcoat>& outClearcoat)
     {
-        OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jClearCoat, "clearcoatFactor", float, outClearcoat->ClearcoatFactor);
+        OCASI_SET_FLOAT_PROPERTY_IF_EXISTS(jClearCoat, "clearcoatFactor", outClearcoat->ClearcoatFactor);
         ParseTextureInfo(jClearCoat, "clearcoatTexture", outClearcoat->ClearcoatTexture);
         
-        OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jClearCoat, "clearcoatRoughnessFactor", float, outClearcoat->ClearcoatRoughnessFactor);
+        OCASI_SET_FLOAT_PROPERTY_IF_EXISTS(jClearCoat, "clearcoatRoughnessFactor", outClearcoat->ClearcoatRoughnessFactor);
         ParseTextureInfo(jClearCoat, "clearcoatRoughnessTexture", outClearcoat->ClearcoatRoughnessTexture);
         
         ParseTextureInfo(jClearCoat, "clearcoatNormalTexture", outClearcoat->ClearcoatNormalTexture);
 
     }
     
-    void JsonParser::ParseSheen(simdjson::fallback::ondemand::object& jSheen, std::optional<KHRMaterialSheen>& outSheen)
+    void JsonParser::ParseSheen(simdjson::dom::object& jSheen, std::optional<KHRMaterialSheen>& outSheen)
     {
-        OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jSheen, "sheenRoughnessFactor", float, outSheen->SheenRoughnessFactor);
+        OCASI_SET_FLOAT_PROPERTY_IF_EXISTS(jSheen, "sheenRoughnessFactor", outSheen->SheenRoughnessFactor);
         ParseTextureInfo(jSheen, "sheenRoughnessTexture", outSheen->SheenRoughnessTexture);
         
         ParseVec3(jSheen, "sheenColorFactor", outSheen->SheenColourFactor);
@@ -695,97 +1129,109 @@ namespace OCASI::GLTF {
         
     }
     
-    void JsonParser::ParseTransmission(simdjson::fallback::ondemand::object& jTransmission, std::optional<KHRMaterialTransmission>& outTransmission)
+    void JsonParser::ParseTransmission(simdjson::dom::object& jTransmission, std::optional<KHRMaterialTransmission>& outTransmission)
     {
-        OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jTransmission, "transmissionFactor", float, outTransmission->TransmissionFactor);
+        OCASI_SET_FLOAT_PROPERTY_IF_EXISTS(jTransmission, "transmissionFactor", outTransmission->TransmissionFactor);
         ParseTextureInfo(jTransmission, "transmissionTexture", outTransmission->TransmissionTexture);
 
     }
     
-    void JsonParser::ParseVolume(simdjson::fallback::ondemand::object& jVolume, std::optional<KHRMaterialVolume>& outVolume)
+    void JsonParser::ParseVolume(simdjson::dom::object& jVolume, std::optional<KHRMaterialVolume>& outVolume)
     {
-        OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jVolume, "thicknessFactor", float, outVolume->ThicknessFactor);
+        OCASI_SET_FLOAT_PROPERTY_IF_EXISTS(jVolume, "thicknessFactor", outVolume->ThicknessFactor);
         ParseTextureInfo(jVolume, "thicknessTexture", outVolume->ThicknessTexture);
         
-        OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jVolume, "attenuationDistance", float, outVolume->AttenuationDistance);
+        OCASI_SET_FLOAT_PROPERTY_IF_EXISTS(jVolume, "attenuationDistance", outVolume->AttenuationDistance);
         ParseVec3(jVolume, "attenuationColor", outVolume->AttenuationColour);
     }
     
-    void JsonParser::ParseIOR(simdjson::fallback::ondemand::object& jIOR, std::optional<KHRMaterialIOR>& outIOR)
+    void JsonParser::ParseIOR(simdjson::dom::object& jIOR, std::optional<KHRMaterialIOR>& outIOR)
     {
-        OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jIOR, "ior", float, outIOR->IOR);
+        OCASI_SET_FLOAT_PROPERTY_IF_EXISTS(jIOR, "ior", outIOR->IOR);
     }
     
-    void JsonParser::ParseEmissiveStrength(simdjson::fallback::ondemand::object& jEmissiveStrength, std::optional<KHRMaterialEmissiveStrength>& outEmissiveStrength)
+    void JsonParser::ParseEmissiveStrength(simdjson::dom::object& jEmissiveStrength, std::optional<KHRMaterialEmissiveStrength>& outEmissiveStrength)
     {
-        OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jEmissiveStrength, "emissiveStrength", float, outEmissiveStrength->EmissiveStrength);
+        OCASI_SET_FLOAT_PROPERTY_IF_EXISTS(jEmissiveStrength, "emissiveStrength", outEmissiveStrength->EmissiveStrength);
     }
     
-    void JsonParser::ParseIridescence(simdjson::fallback::ondemand::object& jIridescence, std::optional<KHRMaterialIridescence>& outIridescence)
+    void JsonParser::ParseIridescence(simdjson::dom::object& jIridescence, std::optional<KHRMaterialIridescence>& outIridescence)
     {
-        OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jIridescence, "iridescenceFactor", float, outIridescence->IridescenceFactor);
-        OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jIridescence, "iridescenceIor", float, outIridescence->IridescenceIor);
+        OCASI_SET_FLOAT_PROPERTY_IF_EXISTS(jIridescence, "iridescenceFactor", outIridescence->IridescenceFactor);
+        OCASI_SET_FLOAT_PROPERTY_IF_EXISTS(jIridescence, "iridescenceIor", outIridescence->IridescenceIor);
         ParseTextureInfo(jIridescence, "iridescenceTexture", outIridescence->IridescenceTexture);
         
-        OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jIridescence, "iridescenceThicknessMinimum", float, outIridescence->IridescenceThicknessMinimum);
-        OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jIridescence, "iridescenceThicknessMaximum", float, outIridescence->IridescenceThicknessMaximum);
+        OCASI_SET_FLOAT_PROPERTY_IF_EXISTS(jIridescence, "iridescenceThicknessMinimum", outIridescence->IridescenceThicknessMinimum);
+        OCASI_SET_FLOAT_PROPERTY_IF_EXISTS(jIridescence, "iridescenceThicknessMaximum", outIridescence->IridescenceThicknessMaximum);
         ParseTextureInfo(jIridescence, "iridescenceThicknessTexture", outIridescence->IridescenceThicknessTexture);
     }
     
-    void JsonParser::ParseAnisotropy(simdjson::fallback::ondemand::object& jAnisotropy, std::optional<KHRMaterialAnisotropy>& outAnisotropy)
+    void JsonParser::ParseAnisotropy(simdjson::dom::object& jAnisotropy, std::optional<KHRMaterialAnisotropy>& outAnisotropy)
     {
-        OCASI_SET_PROPERTY_IF_EXISTS_TEMPLATE(jAnisotropy, "anisotropyFactor", float, outAnisotropy->AnisotropyFactor);
+        OCASI_SET_FLOAT_PROPERTY_IF_EXISTS(jAnisotropy, "anisotropyFactor", outAnisotropy->AnisotropyFactor);
         ParseVec3(jAnisotropy, "anisotropyDirection", outAnisotropy->AnisotropyDirection);
         ParseTextureInfo(jAnisotropy, "anisotropyTexture", outAnisotropy->AnisotropyTexture);
     }
 
-    void JsonParser::ParseVertexAttributes(simdjson::fallback::ondemand::object& jVertexAttributes, VertexAttributes& outAttributes)
+    void JsonParser::ParseVertexAttributes(simdjson::dom::object& jVertexAttributes, VertexAttributes& outAttributes)
     {
         size_t vertexAttributeCount;
         
-        for (auto jAttribute : jVertexAttributes)
+        for (auto [key, value] : jVertexAttributes)
         {
-            std::string_view key;
-            OCASI_FAIL_ON_SIMDJSON_ERROR(jAttribute.escaped_key().get(key), "Failed to get vertex jAttribute key");
-            OCASI_FAIL_ON_SIMDJSON_ERROR(jAttribute.value().get(outAttributes[std::string(key)]), "Failed to get vertex jAttribute value");
+            OCASI_FAIL_ON_SIMDJSON_ERROR(value.get(outAttributes[std::string(key)]), "Failed to get vertex jAttribute value");
         }
     }
     
-    void JsonParser::ParseVec3(simdjson::fallback::ondemand::object& jObject, std::string_view name, glm::vec3& out)
+    void JsonParser::ParseVec3(simdjson::dom::object& jObject, std::string_view name, glm::vec3& out)
     {
-        ondemand::array jVec;
+        dom::element jVec;
         OCASI_HAS_PROPERTY(jObject, name, jVec)
-        {
-            size_t i = 0;
-            for (auto jVecVal : jVec) {
-                
-                float element;
-                OCASI_FAIL_ON_SIMDJSON_ERROR(jVecVal.get<float>().get(element), "Failed to parse vec3 array element");
-                
-                out[(int)i] = element;
-                
-                i++;
-            }
-            OCASI_ASSERT(i == 3);
-        }
+            ParseVec3(jVec, out);
     }
     
-    void JsonParser::ParseVec4(simdjson::fallback::ondemand::object& jObject, std::string_view name, glm::vec4& out)
+    void JsonParser::ParseVec4(simdjson::dom::object& jObject, std::string_view name, glm::vec4& out)
     {
-        ondemand::array jVec;
+        dom::element jVec;
         OCASI_HAS_PROPERTY(jObject, name, jVec)
-        {
-            size_t i = 0;
-            for (auto jVecVal : jVec) {
-                
-                float element;
-                OCASI_FAIL_ON_SIMDJSON_ERROR(jVecVal.get<float>().get(element), "Failed to parse vec4 array element");
-                
-                out[(int)i] = element;
-                
-                i++;
-            }
-            OCASI_ASSERT(i == 4);
+            ParseVec4(jVec, out);
+    }
+
+    void JsonParser::ParseVec3(const simdjson::dom::element& jElement, glm::vec3& out)
+    {
+        dom::array jVec;
+        if (jElement.get(jVec))
+            return;
+
+        size_t i = 0;
+        for (auto jVecVal : jVec) {
+            
+            float element;
+            OCASI_FAIL_ON_SIMDJSON_ERROR(GetFloat(jVecVal, element), "Failed to parse vec3 array element");
+            
+            out[(int)i] = element;
+            
+            i++;
+        }
+        OCASI_ASSERT(i == 3);
+    }
+    
+    void JsonParser::ParseVec4(const simdjson::dom::element& jElement, glm::vec4& out)
+    {
+        dom::array jVec;
+        if (jElement.get(jVec))
+            return;
+
+        size_t i = 0;
+        for (auto jVecVal : jVec) {
+            
+            float element;
+            OCASI_FAIL_ON_SIMDJSON_ERROR(GetFloat(jVecVal, element), "Failed to parse vec4 array element");
+            
+            out[(int)i] = element;
+            
+            i++;
         }
+        OCASI_ASSERT(i == 4);
     }
-}
\ No newline at end of file
+}
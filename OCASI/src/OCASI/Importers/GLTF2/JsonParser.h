@@ -4,9 +4,10 @@
 
 #include "OCASI/Importers/GLTF2/Asset.h"
 
-namespace simdjson::fallback::ondemand {
+namespace simdjson::dom {
     
     class array;
+    class element;
     class object;
     
 }
@@ -14,48 +15,86 @@ namespace simdjson::fallback::ondemand {
 namespace OCASI::GLTF {
     struct Json;
     
+    //! Returns the Json into the pool of the releasing thread.
+    struct JsonReleaser
+    {
+        void operator()(Json* json) const;
+    };
+    
+    using PooledJson = std::unique_ptr<Json, JsonReleaser>;
+    
     class JsonParser
     {
     public:
+        //! @param json The parsed json document. It is not owned by the parser.
         JsonParser(OCASI::FileReader& reader, Json* json);
-        ~JsonParser();
 
         std::shared_ptr<Asset> ParseGLTFTextFile();
+        
+        //! @brief Returns the name of the SIMD kernel, that simdjson selected for this CPU (e.g. "haswell", "arm64" or "fallback").
+        static std::string GetKernelName();
+        //! @brief Returns the names of all kernels, that are supported by this CPU.
+        static std::vector<std::string> GetSupportedKernels();
+        /*! @brief Overrides the kernel, that simdjson selected at runtime. Only meant for benchmarking and testing.
+         *
+         *  @return Whether the kernel exists and is supported by this CPU.
+         */
+        static bool SetKernel(std::string_view name);
+        
+        /*! @brief Takes a Json from the pool of the calling thread, or creates one, if the pool is empty.
+         *
+         *  Pooled parsers and buffers keep the capacity of the largest document they parsed, so importing many files
+         *  in a row does not reallocate them for every file.
+         */
+        static PooledJson AcquireJson();
+        /*! @brief Sets the largest document size in bytes, whose parser and buffer are kept inside the pools.
+         *
+         *  Parsers and buffers, that grew beyond the limit, are freed once the document is parsed. 0 disables pooling.
+         */
+        static void SetJsonPoolLimit(size_t byteSize);
     private:
-        void ParseAssetDescription(); // This is for parsing the Scene's generator and required version
-        void ParseExtensions();
-        void ParseBuffers();
-        void ParseBufferViews();
-        void ParseAccessors();
-        void ParseSparseAccessor(simdjson::fallback::ondemand::object& jsonAccessor, std::optional<Sparse> &outSparse);
-        void ParseImages();
-        void ParseSamplers();
-        void ParseTextures();
-        void ParseTextureInfo(simdjson::fallback::ondemand::object& jObject, std::string_view name, std::optional<TextureInfo>& outTextureInfo);
-        void ParseMaterials();
-        void ParseMeshes();
-        void ParsePrimitives(simdjson::fallback::ondemand::array& jPrimitives, Mesh& mesh);
-        void ParseNodes();
-        void ParseScenes();
+        void ParseAssetDescription(simdjson::dom::object& jAsset); // This is for parsing the Scene's generator and required version
+        void ParseExtensions(simdjson::dom::array& jExtensions);
+        void ParseRequiredExtensions(simdjson::dom::array& jExtensions);
+        void ParseBuffers(simdjson::dom::array& jBuffers);
+        void ParseBufferViews(simdjson::dom::array& jBufferViews);
+        void ParseMeshoptCompression(simdjson::dom::object& jMeshopt, std::optional<MeshoptCompression>& outCompression);
+        void ParseAccessors(simdjson::dom::array& jAccessors);
+        DataType ParseDataType(std::string_view dataType);
+        void ParseSparseAccessor(simdjson::dom::object& jsonAccessor, std::optional<Sparse> &outSparse);
+        void ParseImages(simdjson::dom::array& jImages);
+        void ParseSamplers(simdjson::dom::array& jSamplers);
+        void ParseTextures(simdjson::dom::array& jTextures);
+        void ParseTextureInfo(simdjson::dom::object& jObject, std::string_view name, std::optional<TextureInfo>& outTextureInfo);
+        void ParseTextureInfo(const simdjson::dom::element& jTextureInfo, std::optional<TextureInfo>& outTextureInfo);
+        void ParseMaterials(simdjson::dom::array& jMaterials);
+        void ParseMeshes(simdjson::dom::array& jMeshes);
+        void ParsePrimitives(simdjson::dom::array& jPrimitives, Mesh& mesh);
+        void ParseDracoMeshCompression(simdjson::dom::object& jDraco, std::optional<KHRDracoMeshCompression>& outDraco);
+        void ParseNodes(simdjson::dom::array& jNodes);
+        void ParseScenes(simdjson::dom::array& jScenes);
 
         // Materials
-        void ParsePbrMetallicRoughness(simdjson::fallback::ondemand::object& jPbrMetallicRoughness, std::optional<PBRMetallicRoughness>& outMaterial);
+        void ParsePbrMetallicRoughness(simdjson::dom::object& jPbrMetallicRoughness, std::optional<PBRMetallicRoughness>& outMaterial);
         // Material extensions
-        void ParsePbrSpecularGlossiness(simdjson::fallback::ondemand::object& jPbrSpecularGlossiness, std::optional<KHRMaterialPbrSpecularGlossiness>& outSpecularGlossiness);
-        void ParseSpecular(simdjson::fallback::ondemand::object& jSpecular, std::optional<KHRMaterialSpecular>& outMaterial);
-        void ParseClearcoat(simdjson::fallback::ondemand::object& jClearcoat, std::optional<KHRMaterialClearcoat>& outMaterial);
-        void ParseSheen(simdjson::fallback::ondemand::object& jSheen, std::optional<KHRMaterialSheen>& outMaterial);
-        void ParseTransmission(simdjson::fallback::ondemand::object& jTransmission, std::optional<KHRMaterialTransmission>& outMaterial);
-        void ParseVolume(simdjson::fallback::ondemand::object& jVolume, std::optional<KHRMaterialVolume>& outMaterial);
-        void ParseIOR(simdjson::fallback::ondemand::object& jIOR, std::optional<KHRMaterialIOR>& outMaterial);
-        void ParseEmissiveStrength(simdjson::fallback::ondemand::object& jEmissiveStrength, std::optional<KHRMaterialEmissiveStrength>& outMaterial);
-        void ParseIridescence(simdjson::fallback::ondemand::object& jIridescence, std::optional<KHRMaterialIridescence>& outMaterial);
-        void ParseAnisotropy(simdjson::fallback::ondemand::object& jAnisotropy, std::optional<KHRMaterialAnisotropy>& outMaterial);
+        void ParseMaterialExtensions(simdjson::dom::object& jExtensions, Material& material);
+        void ParsePbrSpecularGlossiness(simdjson::dom::object& jPbrSpecularGlossiness, std::optional<KHRMaterialPbrSpecularGlossiness>& outSpecularGlossiness);
+        void ParseSpecular(simdjson::dom::object& jSpecular, std::optional<KHRMaterialSpecular>& outMaterial);
+        void ParseClearcoat(simdjson::dom::object& jClearcoat, std::optional<KHRMaterialClearcoat>& outMaterial);
+        void ParseSheen(simdjson::dom::object& jSheen, std::optional<KHRMaterialSheen>& outMaterial);
+        void ParseTransmission(simdjson::dom::object& jTransmission, std::optional<KHRMaterialTransmission>& outMaterial);
+        void ParseVolume(simdjson::dom::object& jVolume, std::optional<KHRMaterialVolume>& outMaterial);
+        void ParseIOR(simdjson::dom::object& jIOR, std::optional<KHRMaterialIOR>& outMaterial);
+        void ParseEmissiveStrength(simdjson::dom::object& jEmissiveStrength, std::optional<KHRMaterialEmissiveStrength>& outMaterial);
+        void ParseIridescence(simdjson::dom::object& jIridescence, std::optional<KHRMaterialIridescence>& outMaterial);
+        void ParseAnisotropy(simdjson::dom::object& jAnisotropy, std::optional<KHRMaterialAnisotropy>& outMaterial);
 
         // Mesh data loading
-        void ParseVertexAttributes(simdjson::fallback::ondemand::object& jVertexAttributes, VertexAttributes& outAttributes);
-        void ParseVec3(simdjson::fallback::ondemand::object& jObject, std::string_view name, glm::vec3& out);
-        void ParseVec4(simdjson::fallback::ondemand::object& jObject, std::string_view name, glm::vec4& out);
+        void ParseVertexAttributes(simdjson::dom::object& jVertexAttributes, VertexAttributes& outAttributes);
+        void ParseVec3(simdjson::dom::object& jObject, std::string_view name, glm::vec3& out);
+        void ParseVec4(simdjson::dom::object& jObject, std::string_view name, glm::vec4& out);
+        void ParseVec3(const simdjson::dom::element& jVec, glm::vec3& out);
+        void ParseVec4(const simdjson::dom::element& jVec, glm::vec4& out);
     private:
         FileReader& m_FileReader;
 
@@ -0,0 +1,867 @@
+#include "MeshoptDecoder.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// The instruction set is selected at compile time like the one of the base64 decoder. The byte groups with escaped
+// values need a byte shuffle, which SSSE3 (and therefore every AVX2 build) provides. Plain SSE2 builds decode the
+// delta and transposition steps, as well as the filters, with vector instructions and only fall back to scalar code
+// for groups containing escaped values.
+#if defined(__AVX2__) || defined(__SSSE3__)
+    #define OCASI_MESHOPT_SSSE3
+    #define OCASI_MESHOPT_SSE2
+    #include <tmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define OCASI_MESHOPT_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace OCASI::GLTF {
+
+    namespace {
+
+        // Vertex codec
+        constexpr uint8_t VERTEX_HEADER = 0xa0;
+        constexpr size_t VERTEX_BLOCK_SIZE_BYTES = 8192;
+        constexpr size_t VERTEX_BLOCK_MAX_SIZE = 256;
+        constexpr size_t MAX_VERTEX_SIZE = 256;
+        constexpr size_t BYTE_GROUP_SIZE = 16;
+        // The largest encoded byte group: 8 bytes of 4 bit values, followed by 16 escaped values
+        constexpr size_t BYTE_GROUP_DECODE_LIMIT = 24;
+        constexpr size_t TAIL_MAX_SIZE = 32;
+
+        // Index codecs
+        constexpr uint8_t INDEX_HEADER = 0xe0;
+        constexpr uint8_t SEQUENCE_HEADER = 0xd0;
+        constexpr size_t CODE_AUX_TABLE_SIZE = 16;
+        constexpr size_t SEQUENCE_TAIL_SIZE = 4;
+        constexpr size_t FIFO_SIZE = 16;
+
+        [[noreturn]] void ThrowMalformedData(std::string_view codec)
+        {
+            throw FailedImportError(FORMAT("Could not decode EXT_meshopt_compression {} data, as it is truncated or malformed.", codec));
+        }
+
+        size_t GetVertexBlockSize(size_t vertexSize)
+        {
+            // A block has to fit into the transposition buffer and is a whole number of byte groups
+            size_t blockSize = (VERTEX_BLOCK_SIZE_BYTES / vertexSize) & ~(BYTE_GROUP_SIZE - 1);
+            return std::min(blockSize, VERTEX_BLOCK_MAX_SIZE);
+        }
+
+        [[maybe_unused]] uint8_t Unzigzag8(uint8_t value)
+        {
+            return (uint8_t) (-(value & 1) ^ (value >> 1));
+        }
+
+        // Decodes 16 values of Bits bits. Values, that have all bits set, are stored in the bytes following the group.
+        template<uint32_t Bits>
+        const uint8_t* DecodeBitsGroupScalar(const uint8_t* data, uint8_t* out)
+        {
+            constexpr uint32_t ESCAPE = (1 << Bits) - 1;
+            const uint8_t* escaped = data + BYTE_GROUP_SIZE * Bits / 8;
+
+            for (size_t i = 0; i < BYTE_GROUP_SIZE; i++)
+            {
+                // The first value is stored in the highest bits
+                uint32_t shift = 8 - Bits - (i * Bits) % 8;
+                uint8_t value = (data[i * Bits / 8] >> shift) & ESCAPE;
+                out[i] = value == ESCAPE ? *escaped++ : value;
+            }
+            return escaped;
+        }
+
+#if defined(OCASI_MESHOPT_SSE2)
+
+        constexpr std::array<std::array<uint8_t, 8>, 256> CreateEscapeShuffleTable()
+        {
+            // Maps the escaped lanes of 8 values to the consecutive escaped bytes, other lanes are zeroed by the shuffle
+            std::array<std::array<uint8_t, 8>, 256> table = {};
+            for (size_t mask = 0; mask < 256; mask++)
+            {
+                uint8_t next = 0;
+                for (size_t i = 0; i < 8; i++)
+                    table[mask][i] = (mask & (1 << i)) ? next++ : 0x80;
+            }
+            return table;
+        }
+
+        [[maybe_unused]] constexpr std::array<std::array<uint8_t, 8>, 256> ESCAPE_SHUFFLE_TABLE = CreateEscapeShuffleTable();
+
+        template<uint32_t Bits>
+        const uint8_t* DecodeBitsGroup(const uint8_t* data, uint8_t* out)
+        {
+            constexpr size_t GROUP_BYTES = BYTE_GROUP_SIZE * Bits / 8;
+
+            __m128i values;
+            if constexpr (Bits == 2)
+            {
+                // Every byte holds 4 values from the high to the low bits
+                int32_t packedBytes;
+                std::memcpy(&packedBytes, data, sizeof(int32_t));
+                __m128i packed = _mm_cvtsi32_si128(packedBytes);
+                __m128i mask = _mm_set1_epi8(3);
+                __m128i bits6 = _mm_and_si128(_mm_srli_epi16(packed, 6), mask);
+                __m128i bits4 = _mm_and_si128(_mm_srli_epi16(packed, 4), mask);
+                __m128i bits2 = _mm_and_si128(_mm_srli_epi16(packed, 2), mask);
+                __m128i bits0 = _mm_and_si128(packed, mask);
+                values = _mm_unpacklo_epi16(_mm_unpacklo_epi8(bits6, bits4), _mm_unpacklo_epi8(bits2, bits0));
+            }
+            else
+            {
+                __m128i packed = _mm_loadl_epi64((const __m128i*) data);
+                __m128i mask = _mm_set1_epi8(15);
+                values = _mm_unpacklo_epi8(_mm_and_si128(_mm_srli_epi16(packed, 4), mask), _mm_and_si128(packed, mask));
+            }
+
+            __m128i escapes = _mm_cmpeq_epi8(values, _mm_set1_epi8((char) ((1 << Bits) - 1)));
+            uint32_t escapeMask = (uint32_t) _mm_movemask_epi8(escapes);
+            if (escapeMask == 0)
+            {
+                _mm_storeu_si128((__m128i*) out, values);
+                return data + GROUP_BYTES;
+            }
+
+#if defined(OCASI_MESHOPT_SSSE3)
+            // The decode limit guarantees, that 16 bytes can be read after the packed values
+            uint32_t lowCount = std::popcount(escapeMask & 0xff);
+            __m128i lowShuffle = _mm_loadl_epi64((const __m128i*) ESCAPE_SHUFFLE_TABLE[escapeMask & 0xff].data());
+            __m128i highShuffle = _mm_add_epi8(_mm_loadl_epi64((const __m128i*) ESCAPE_SHUFFLE_TABLE[escapeMask >> 8].data()), _mm_set1_epi8((char) lowCount));
+            __m128i escapedBytes = _mm_loadu_si128((const __m128i*) (data + GROUP_BYTES));
+            __m128i escapedValues = _mm_shuffle_epi8(escapedBytes, _mm_unpacklo_epi64(lowShuffle, highShuffle));
+
+            _mm_storeu_si128((__m128i*) out, _mm_or_si128(_mm_andnot_si128(escapes, values), escapedValues));
+            return data + GROUP_BYTES + std::popcount(escapeMask);
+#else
+            return DecodeBitsGroupScalar<Bits>(data, out);
+#endif
+        }
+
+        const uint8_t* DecodeBytesGroup(const uint8_t* data, uint8_t* out, uint32_t mode)
+        {
+            switch (mode)
+            {
+                case 0:
+                    _mm_storeu_si128((__m128i*) out, _mm_setzero_si128());
+                    return data;
+                case 1:
+                    return DecodeBitsGroup<2>(data, out);
+                case 2:
+                    return DecodeBitsGroup<4>(data, out);
+                default:
+                    _mm_storeu_si128((__m128i*) out, _mm_loadu_si128((const __m128i*) data));
+                    return data + BYTE_GROUP_SIZE;
+            }
+        }
+
+#else
+
+        const uint8_t* DecodeBytesGroup(const uint8_t* data, uint8_t* out, uint32_t mode)
+        {
+            switch (mode)
+            {
+                case 0:
+                    std::memset(out, 0, BYTE_GROUP_SIZE);
+                    return data;
+                case 1:
+                    return DecodeBitsGroupScalar<2>(data, out);
+                case 2:
+                    return DecodeBitsGroupScalar<4>(data, out);
+                default:
+                    std::memcpy(out, data, BYTE_GROUP_SIZE);
+                    return data + BYTE_GROUP_SIZE;
+            }
+        }
+
+#endif
+
+        // Decodes one byte of size vertices. The 2 bit mode of every group of 16 bytes is stored in front of the groups.
+        const uint8_t* DecodeBytes(const uint8_t* data, const uint8_t* dataEnd, uint8_t* out, size_t size)
+        {
+            const uint8_t* header = data;
+            size_t headerSize = (size / BYTE_GROUP_SIZE + 3) / 4;
+            if ((size_t) (dataEnd - data) < headerSize)
+                ThrowMalformedData("vertex");
+            data += headerSize;
+
+            for (size_t i = 0; i < size; i += BYTE_GROUP_SIZE)
+            {
+                if ((size_t) (dataEnd - data) < BYTE_GROUP_DECODE_LIMIT)
+                    ThrowMalformedData("vertex");
+
+                size_t group = i / BYTE_GROUP_SIZE;
+                uint32_t mode = (header[group / 4] >> ((group % 4) * 2)) & 3;
+                data = DecodeBytesGroup(data, out + i, mode);
+            }
+            return data;
+        }
+
+#if defined(OCASI_MESHOPT_SSE2)
+
+        // Reverts the zigzag and delta encoding of 16 bytes. carry holds the previous value in every lane.
+        __m128i DecodeDeltas(__m128i values, __m128i& carry)
+        {
+            __m128i sign = _mm_sub_epi8(_mm_setzero_si128(), _mm_and_si128(values, _mm_set1_epi8(1)));
+            __m128i magnitude = _mm_and_si128(_mm_srli_epi16(values, 1), _mm_set1_epi8(0x7f));
+            __m128i result = _mm_xor_si128(sign, magnitude);
+
+            result = _mm_add_epi8(result, _mm_slli_si128(result, 1));
+            result = _mm_add_epi8(result, _mm_slli_si128(result, 2));
+            result = _mm_add_epi8(result, _mm_slli_si128(result, 4));
+            result = _mm_add_epi8(result, _mm_slli_si128(result, 8));
+            result = _mm_add_epi8(result, carry);
+
+            // Broadcast the last byte for the next group
+            carry = _mm_shuffle_epi32(_mm_shufflehi_epi16(_mm_unpackhi_epi8(result, result), 0xff), 0xff);
+            return result;
+        }
+
+        const uint8_t* DecodeVertexBlock(const uint8_t* data, const uint8_t* dataEnd, uint8_t* vertexData, size_t vertexCount, size_t vertexSize, uint8_t* lastVertex)
+        {
+            alignas(16) uint8_t buffer[4][VERTEX_BLOCK_MAX_SIZE];
+            alignas(16) uint8_t transposed[VERTEX_BLOCK_SIZE_BYTES];
+            size_t alignedCount = (vertexCount + BYTE_GROUP_SIZE - 1) & ~(BYTE_GROUP_SIZE - 1);
+
+            // The vertex size is a multiple of 4, so 4 bytes of 16 vertices are transposed together
+            for (size_t k = 0; k < vertexSize; k += 4)
+            {
+                __m128i carry[4];
+                for (size_t j = 0; j < 4; j++)
+                {
+                    data = DecodeBytes(data, dataEnd, buffer[j], alignedCount);
+                    carry[j] = _mm_set1_epi8((char) lastVertex[k + j]);
+                }
+
+                for (size_t i = 0; i < alignedCount; i += BYTE_GROUP_SIZE)
+                {
+                    __m128i byte0 = DecodeDeltas(_mm_load_si128((const __m128i*) (buffer[0] + i)), carry[0]);
+                    __m128i byte1 = DecodeDeltas(_mm_load_si128((const __m128i*) (buffer[1] + i)), carry[1]);
+                    __m128i byte2 = DecodeDeltas(_mm_load_si128((const __m128i*) (buffer[2] + i)), carry[2]);
+                    __m128i byte3 = DecodeDeltas(_mm_load_si128((const __m128i*) (buffer[3] + i)), carry[3]);
+
+                    __m128i bytes01Low = _mm_unpacklo_epi8(byte0, byte1);
+                    __m128i bytes01High = _mm_unpackhi_epi8(byte0, byte1);
+                    __m128i bytes23Low = _mm_unpacklo_epi8(byte2, byte3);
+                    __m128i bytes23High = _mm_unpackhi_epi8(byte2, byte3);
+
+                    __m128i vertices[4] =
+                    {
+                        _mm_unpacklo_epi16(bytes01Low, bytes23Low),
+                        _mm_unpackhi_epi16(bytes01Low, bytes23Low),
+                        _mm_unpacklo_epi16(bytes01High, bytes23High),
+                        _mm_unpackhi_epi16(bytes01High, bytes23High)
+                    };
+
+                    uint8_t* out = transposed + i * vertexSize + k;
+                    for (size_t v = 0; v < 4; v++)
+                    {
+                        if (vertexSize == 4)
+                        {
+                            _mm_storeu_si128((__m128i*) (out + v * 16), vertices[v]);
+                            continue;
+                        }
+
+                        for (size_t n = 0; n < 4; n++)
+                        {
+                            int32_t value = _mm_cvtsi128_si32(vertices[v]);
+                            std::memcpy(out + (v * 4 + n) * vertexSize, &value, sizeof(int32_t));
+                            vertices[v] = _mm_srli_si128(vertices[v], 4);
+                        }
+                    }
+                }
+            }
+
+            std::memcpy(vertexData, transposed, vertexCount * vertexSize);
+            std::memcpy(lastVertex, transposed + vertexSize * (vertexCount - 1), vertexSize);
+            return data;
+        }
+
+#else
+
+        const uint8_t* DecodeVertexBlock(const uint8_t* data, const uint8_t* dataEnd, uint8_t* vertexData, size_t vertexCount, size_t vertexSize, uint8_t* lastVertex)
+        {
+            uint8_t buffer[VERTEX_BLOCK_MAX_SIZE];
+            uint8_t transposed[VERTEX_BLOCK_SIZE_BYTES];
+            size_t alignedCount = (vertexCount + BYTE_GROUP_SIZE - 1) & ~(BYTE_GROUP_SIZE - 1);
+
+            for (size_t k = 0; k < vertexSize; k++)
+            {
+                data = DecodeBytes(data, dataEnd, buffer, alignedCount);
+
+                uint8_t previous = lastVertex[k];
+                for (size_t i = 0; i < vertexCount; i++)
+                {
+                    previous = (uint8_t) (Unzigzag8(buffer[i]) + previous);
+                    transposed[i * vertexSize + k] = previous;
+                }
+            }
+
+            std::memcpy(vertexData, transposed, vertexCount * vertexSize);
+            std::memcpy(lastVertex, transposed + vertexSize * (vertexCount - 1), vertexSize);
+            return data;
+        }
+
+#endif
+
+        uint32_t DecodeVByte(const uint8_t*& data)
+        {
+            uint8_t lead = *data++;
+            if (lead < 128)
+                return lead;
+
+            // Values are stored in 7 bit groups with the high bit marking, that another group follows
+            uint32_t result = lead & 127;
+            uint32_t shift = 7;
+            for (size_t i = 0; i < 4; i++)
+            {
+                uint8_t group = *data++;
+                result |= (uint32_t) (group & 127) << shift;
+                shift += 7;
+
+                if (group < 128)
+                    break;
+            }
+            return result;
+        }
+
+        uint32_t DecodeIndex(const uint8_t*& data, uint32_t last)
+        {
+            uint32_t value = DecodeVByte(data);
+            uint32_t delta = (value >> 1) ^ -(int32_t) (value & 1);
+            return last + delta;
+        }
+
+        void WriteIndex(uint8_t* out, size_t i, size_t indexSize, uint32_t index)
+        {
+            if (indexSize == 2)
+            {
+                uint16_t shortIndex = (uint16_t) index;
+                std::memcpy(out + i * 2, &shortIndex, sizeof(uint16_t));
+            }
+            else
+            {
+                std::memcpy(out + i * 4, &index, sizeof(uint32_t));
+            }
+        }
+
+        void CheckIndexSize(size_t indexSize)
+        {
+            if (indexSize != 2 && indexSize != 4)
+                throw FailedImportError(FORMAT("EXT_meshopt_compression indices have to be 2 or 4 bytes large, but {} bytes were specified.", indexSize));
+        }
+
+        // The triangle codec references recently seen edges and vertices through two fifos of 16 entries
+        class TriangleFifos
+        {
+        public:
+            TriangleFifos()
+            {
+                m_Edges.fill({ ~0u, ~0u });
+                m_Vertices.fill(~0u);
+            }
+
+            const std::array<uint32_t, 2>& GetEdge(size_t index) const { return m_Edges[(m_EdgeOffset - 1 - index) & (FIFO_SIZE - 1)]; }
+            uint32_t GetVertex(size_t index) const { return m_Vertices[(m_VertexOffset - 1 - index) & (FIFO_SIZE - 1)]; }
+
+            void PushEdge(uint32_t a, uint32_t b)
+            {
+                m_Edges[m_EdgeOffset] = { a, b };
+                m_EdgeOffset = (m_EdgeOffset + 1) & (FIFO_SIZE - 1);
+            }
+
+            void PushVertex(uint32_t vertex, bool condition = true)
+            {
+                m_Vertices[m_VertexOffset] = vertex;
+                m_VertexOffset = (m_VertexOffset + condition) & (FIFO_SIZE - 1);
+            }
+        private:
+            std::array<std::array<uint32_t, 2>, FIFO_SIZE> m_Edges;
+            std::array<uint32_t, FIFO_SIZE> m_Vertices;
+            size_t m_EdgeOffset = 0;
+            size_t m_VertexOffset = 0;
+        };
+
+#if defined(OCASI_MESHOPT_SSE2)
+
+        // Rounds half away from zero, like the scalar filters
+        __m128i RoundToInt(__m128 value)
+        {
+            __m128 half = _mm_or_ps(_mm_and_ps(value, _mm_set1_ps(-0.0f)), _mm_set1_ps(0.5f));
+            return _mm_cvttps_epi32(_mm_add_ps(value, half));
+        }
+
+        // Reconstructs 4 unit vectors from their octahedral encoding and scales them to max
+        void DecodeOctahedral(__m128 x, __m128 y, __m128 z, float max, __m128i& outX, __m128i& outY, __m128i& outZ)
+        {
+            const __m128 signMask = _mm_set1_ps(-0.0f);
+            z = _mm_sub_ps(_mm_sub_ps(z, _mm_andnot_ps(signMask, x)), _mm_andnot_ps(signMask, y));
+
+            // Unfolds the lower hemisphere: x += x >= 0 ? t : -t
+            __m128 t = _mm_min_ps(z, _mm_setzero_ps());
+            x = _mm_add_ps(x, _mm_xor_ps(t, _mm_and_ps(x, signMask)));
+            y = _mm_add_ps(y, _mm_xor_ps(t, _mm_and_ps(y, signMask)));
+
+            __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+            __m128 scale = _mm_div_ps(_mm_set1_ps(max), length);
+
+            outX = RoundToInt(_mm_mul_ps(x, scale));
+            outY = RoundToInt(_mm_mul_ps(y, scale));
+            outZ = RoundToInt(_mm_mul_ps(z, scale));
+        }
+
+        // Sign extends the 16 bit components of 4 vectors (2 per register) into one register per component
+        void LoadShortVectors(const uint8_t* data, __m128i& outX, __m128i& outY, __m128i& outZ, __m128i& outW)
+        {
+            __m128i vectors01 = _mm_loadu_si128((const __m128i*) data);
+            __m128i vectors23 = _mm_loadu_si128((const __m128i*) (data + 16));
+
+            __m128i low = _mm_unpacklo_epi16(vectors01, vectors23);
+            __m128i high = _mm_unpackhi_epi16(vectors01, vectors23);
+            __m128i xy = _mm_unpacklo_epi16(low, high);
+            __m128i zw = _mm_unpackhi_epi16(low, high);
+
+            outX = _mm_srai_epi32(_mm_unpacklo_epi16(xy, xy), 16);
+            outY = _mm_srai_epi32(_mm_unpackhi_epi16(xy, xy), 16);
+            outZ = _mm_srai_epi32(_mm_unpacklo_epi16(zw, zw), 16);
+            outW = _mm_srai_epi32(_mm_unpackhi_epi16(zw, zw), 16);
+        }
+
+        void StoreShortVectors(uint8_t* data, __m128i x, __m128i y, __m128i z, __m128i w)
+        {
+            __m128i xy = _mm_packs_epi32(x, y);
+            __m128i zw = _mm_packs_epi32(z, w);
+
+            __m128i xz = _mm_unpacklo_epi16(xy, zw);
+            __m128i yw = _mm_unpackhi_epi16(xy, zw);
+
+            _mm_storeu_si128((__m128i*) data, _mm_unpacklo_epi16(xz, yw));
+            _mm_storeu_si128((__m128i*) (data + 16), _mm_unpackhi_epi16(xz, yw));
+        }
+
+#endif
+
+        template<typename T>
+        void DecodeOctahedralScalar(uint8_t* data, size_t count)
+        {
+            constexpr float max = (float) std::numeric_limits<T>::max();
+
+            for (size_t i = 0; i < count; i++)
+            {
+                T vector[4];
+                std::memcpy(vector, data + i * sizeof(vector), sizeof(vector));
+
+                float x = (float) vector[0];
+                float y = (float) vector[1];
+                float z = (float) vector[2] - std::fabs(x) - std::fabs(y);
+
+                float t = z >= 0.0f ? 0.0f : z;
+                x += x >= 0.0f ? t : -t;
+                y += y >= 0.0f ? t : -t;
+
+                float length = std::sqrt(x * x + y * y + z * z);
+                float scale = max / length;
+
+                vector[0] = (T) (int32_t) (x * scale + (x >= 0.0f ? 0.5f : -0.5f));
+                vector[1] = (T) (int32_t) (y * scale + (y >= 0.0f ? 0.5f : -0.5f));
+                vector[2] = (T) (int32_t) (z * scale + (z >= 0.0f ? 0.5f : -0.5f));
+                std::memcpy(data + i * sizeof(vector), vector, sizeof(vector));
+            }
+        }
+
+        void DecodeOctahedral8(uint8_t* data, size_t count)
+        {
+            size_t i = 0;
+#if defined(OCASI_MESHOPT_SSE2)
+            // Every 32 bit lane holds one vector
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128i vectors = _mm_loadu_si128((const __m128i*) (data + i * 4));
+                __m128 x = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(vectors, 24), 24));
+                __m128 y = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(vectors, 16), 24));
+                __m128 z = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(vectors, 8), 24));
+
+                __m128i outX, outY, outZ;
+                DecodeOctahedral(x, y, z, 127.0f, outX, outY, outZ);
+
+                __m128i byteMask = _mm_set1_epi32(0xff);
+                __m128i result = _mm_and_si128(vectors, _mm_set1_epi32((int32_t) 0xff000000));
+                result = _mm_or_si128(result, _mm_and_si128(outX, byteMask));
+                result = _mm_or_si128(result, _mm_slli_epi32(_mm_and_si128(outY, byteMask), 8));
+                result = _mm_or_si128(result, _mm_slli_epi32(_mm_and_si128(outZ, byteMask), 16));
+                _mm_storeu_si128((__m128i*) (data + i * 4), result);
+            }
+#endif
+            DecodeOctahedralScalar<int8_t>(data + i * 4, count - i);
+        }
+
+        void DecodeOctahedral16(uint8_t* data, size_t count)
+        {
+            size_t i = 0;
+#if defined(OCASI_MESHOPT_SSE2)
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128i x, y, z, w;
+                LoadShortVectors(data + i * 8, x, y, z, w);
+
+                __m128i outX, outY, outZ;
+                DecodeOctahedral(_mm_cvtepi32_ps(x), _mm_cvtepi32_ps(y), _mm_cvtepi32_ps(z), 32767.0f, outX, outY, outZ);
+                StoreShortVectors(data + i * 8, outX, outY, outZ, w);
+            }
+#endif
+            DecodeOctahedralScalar<int16_t>(data + i * 8, count - i);
+        }
+
+        // The largest component is dropped and its index is stored in the low 2 bits of the 4th component, the other
+        // bits store the scale of the remaining components
+        void WriteQuaternion(uint8_t* data, int32_t x, int32_t y, int32_t z, int32_t w, int32_t storedW)
+        {
+            int16_t quaternion[4];
+            int32_t largest = storedW & 3;
+            quaternion[(largest + 1) & 3] = (int16_t) x;
+            quaternion[(largest + 2) & 3] = (int16_t) y;
+            quaternion[(largest + 3) & 3] = (int16_t) z;
+            quaternion[(largest + 0) & 3] = (int16_t) w;
+            std::memcpy(data, quaternion, sizeof(quaternion));
+        }
+
+        void DecodeQuaternion(uint8_t* data, size_t count)
+        {
+            const float scale = 1.0f / std::sqrt(2.0f);
+
+            size_t i = 0;
+#if defined(OCASI_MESHOPT_SSE2)
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128i x, y, z, w;
+                LoadShortVectors(data + i * 8, x, y, z, w);
+
+                __m128 componentScale = _mm_div_ps(_mm_set1_ps(scale), _mm_cvtepi32_ps(_mm_or_si128(w, _mm_set1_epi32(3))));
+                __m128 fx = _mm_mul_ps(_mm_cvtepi32_ps(x), componentScale);
+                __m128 fy = _mm_mul_ps(_mm_cvtepi32_ps(y), componentScale);
+                __m128 fz = _mm_mul_ps(_mm_cvtepi32_ps(z), componentScale);
+
+                // The dropped component is reconstructed from the unit length, clamped to avoid NaNs from rounding errors
+                __m128 ww = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(fx, fx)), _mm_mul_ps(fy, fy)), _mm_mul_ps(fz, fz));
+                __m128 fw = _mm_sqrt_ps(_mm_max_ps(ww, _mm_setzero_ps()));
+
+                alignas(16) int32_t components[5][4];
+                _mm_store_si128((__m128i*) components[0], RoundToInt(_mm_mul_ps(fx, _mm_set1_ps(32767.0f))));
+                _mm_store_si128((__m128i*) components[1], RoundToInt(_mm_mul_ps(fy, _mm_set1_ps(32767.0f))));
+                _mm_store_si128((__m128i*) components[2], RoundToInt(_mm_mul_ps(fz, _mm_set1_ps(32767.0f))));
+                _mm_store_si128((__m128i*) components[3], _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(fw, _mm_set1_ps(32767.0f)), _mm_set1_ps(0.5f))));
+                _mm_store_si128((__m128i*) components[4], w);
+
+                for (size_t n = 0; n < 4; n++)
+                    WriteQuaternion(data + (i + n) * 8, components[0][n], components[1][n], components[2][n], components[3][n], components[4][n]);
+            }
+#endif
+            for (; i < count; i++)
+            {
+                int16_t quaternion[4];
+                std::memcpy(quaternion, data + i * 8, sizeof(quaternion));
+
+                float componentScale = scale / (float) (quaternion[3] | 3);
+                float x = (float) quaternion[0] * componentScale;
+                float y = (float) quaternion[1] * componentScale;
+                float z = (float) quaternion[2] * componentScale;
+
+                float ww = 1.0f - x * x - y * y - z * z;
+                float w = std::sqrt(ww >= 0.0f ? ww : 0.0f);
+
+                WriteQuaternion(data + i * 8,
+                                (int32_t) (x * 32767.0f + (x >= 0.0f ? 0.5f : -0.5f)),
+                                (int32_t) (y * 32767.0f + (y >= 0.0f ? 0.5f : -0.5f)),
+                                (int32_t) (z * 32767.0f + (z >= 0.0f ? 0.5f : -0.5f)),
+                                (int32_t) (w * 32767.0f + 0.5f),
+                                quaternion[3]);
+            }
+        }
+
+        // Every 32 bit value stores a 24 bit signed mantissa and an 8 bit signed exponent
+        void DecodeExponential(uint8_t* data, size_t count)
+        {
+            size_t i = 0;
+#if defined(OCASI_MESHOPT_SSE2)
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128i values = _mm_loadu_si128((const __m128i*) (data + i * 4));
+                __m128i mantissa = _mm_srai_epi32(_mm_slli_epi32(values, 8), 8);
+                __m128i exponent = _mm_srai_epi32(values, 24);
+
+                __m128 power = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(exponent, _mm_set1_epi32(127)), 23));
+                _mm_storeu_ps((float*) (data + i * 4), _mm_mul_ps(power, _mm_cvtepi32_ps(mantissa)));
+            }
+#endif
+            for (; i < count; i++)
+            {
+                uint32_t value;
+                std::memcpy(&value, data + i * 4, sizeof(uint32_t));
+
+                int32_t mantissa = (int32_t) (value << 8) >> 8;
+                int32_t exponent = (int32_t) value >> 24;
+
+                uint32_t powerBits = (uint32_t) (exponent + 127) << 23;
+                float power;
+                std::memcpy(&power, &powerBits, sizeof(float));
+
+                float result = power * (float) mantissa;
+                std::memcpy(data + i * 4, &result, sizeof(float));
+            }
+        }
+    }
+
+    const char* GetMeshoptInstructionSet()
+    {
+#if defined(OCASI_MESHOPT_SSSE3)
+        return "SSSE3";
+#elif defined(OCASI_MESHOPT_SSE2)
+        return "SSE2";
+#else
+        return "Scalar";
+#endif
+    }
+
+    void DecodeMeshoptVertexBuffer(std::span<uint8_t> out, size_t vertexCount, size_t vertexSize, std::span<const uint8_t> data)
+    {
+        if (vertexSize == 0 || vertexSize > MAX_VERTEX_SIZE || vertexSize % 4 != 0)
+            throw FailedImportError(FORMAT("EXT_meshopt_compression attributes have to be a multiple of 4 and at most {} bytes large, but {} bytes were specified.", MAX_VERTEX_SIZE, vertexSize));
+        if (out.size() != vertexCount * vertexSize)
+            throw FailedImportError("The output buffer does not match the size of the EXT_meshopt_compression attributes.");
+        if (data.size() < 1 + vertexSize)
+            ThrowMalformedData("vertex");
+
+        const uint8_t* cursor = data.data();
+        const uint8_t* dataEnd = data.data() + data.size();
+
+        uint8_t header = *cursor++;
+        if ((header & 0xf0) != VERTEX_HEADER)
+            ThrowMalformedData("vertex");
+        if ((header & 0x0f) > 0)
+            throw FailedImportError(FORMAT("Unsupported EXT_meshopt_compression vertex codec version {}.", header & 0x0f));
+
+        // The deltas of the first vertex are relative to the vertex stored in the tail
+        uint8_t lastVertex[MAX_VERTEX_SIZE];
+        std::memcpy(lastVertex, dataEnd - vertexSize, vertexSize);
+
+        size_t blockSize = GetVertexBlockSize(vertexSize);
+        for (size_t offset = 0; offset < vertexCount; offset += blockSize)
+        {
+            size_t count = std::min(blockSize, vertexCount - offset);
+            cursor = DecodeVertexBlock(cursor, dataEnd, out.data() + offset * vertexSize, count, vertexSize, lastVertex);
+        }
+
+        if ((size_t) (dataEnd - cursor) != std::max(vertexSize, TAIL_MAX_SIZE))
+            ThrowMalformedData("vertex");
+    }
+
+    void DecodeMeshoptIndexBuffer(std::span<uint8_t> out, size_t indexCount, size_t indexSize, std::span<const uint8_t> data)
+    {
+        CheckIndexSize(indexSize);
+        if (indexCount % 3 != 0)
+            throw FailedImportError(FORMAT("EXT_meshopt_compression triangles need an index count, that is a multiple of 3, but the count is {}.", indexCount));
+        if (out.size() != indexCount * indexSize)
+            throw FailedImportError("The output buffer does not match the size of the EXT_meshopt_compression triangles.");
+        // Every triangle has a code byte and the data ends with the auxiliary code table
+        if (data.size() < 1 + indexCount / 3 + CODE_AUX_TABLE_SIZE)
+            ThrowMalformedData("triangle");
+
+        uint8_t header = data[0];
+        if ((header & 0xf0) != INDEX_HEADER)
+            ThrowMalformedData("triangle");
+        uint32_t version = header & 0x0f;
+        if (version > 1)
+            throw FailedImportError(FORMAT("Unsupported EXT_meshopt_compression triangle codec version {}.", version));
+
+        // Version 1 encodes the vertex after or before the last free vertex as fec 14 and 13
+        uint32_t maxFifoCode = version >= 1 ? 13 : 15;
+
+        const uint8_t* code = data.data() + 1;
+        const uint8_t* cursor = code + indexCount / 3;
+        const uint8_t* dataSafeEnd = data.data() + data.size() - CODE_AUX_TABLE_SIZE;
+        const uint8_t* codeAuxTable = dataSafeEnd;
+
+        TriangleFifos fifos;
+        uint32_t next = 0;
+        uint32_t last = 0;
+
+        for (size_t i = 0; i < indexCount; i += 3)
+        {
+            // A triangle reads at most 16 bytes, which the code table behind the data guarantees
+            if (cursor > dataSafeEnd)
+                ThrowMalformedData("triangle");
+
+            uint8_t codeTri = *code++;
+            uint32_t a, b, c;
+
+            if (codeTri < 0xf0)
+            {
+                // The triangle shares an edge with a recent triangle
+                const std::array<uint32_t, 2>& edge = fifos.GetEdge(codeTri >> 4);
+                a = edge[0];
+                b = edge[1];
+
+                uint32_t fec = codeTri & 15;
+                if (fec < maxFifoCode)
+                {
+                    c = fec == 0 ? next++ : fifos.GetVertex(fec);
+                    fifos.PushVertex(c, fec == 0);
+                }
+                else
+                {
+                    // fec - (fec ^ 3) decodes 13 and 14 into -1 and 1
+                    last = c = fec != 15 ? last + (fec - (fec ^ 3)) : DecodeIndex(cursor, last);
+                    fifos.PushVertex(c);
+                }
+
+                fifos.PushEdge(c, b);
+                fifos.PushEdge(a, c);
+            }
+            else
+            {
+                uint8_t codeAux;
+                uint32_t fea, feb, fec;
+
+                if (codeTri < 0xfe)
+                {
+                    // The table never contains free vertices (15)
+                    codeAux = codeAuxTable[codeTri & 15];
+                    fea = 0;
+                }
+                else
+                {
+                    codeAux = *cursor++;
+                    fea = codeTri == 0xfe ? 0 : 15;
+
+                    // An explicit zero code resets the next vertex
+                    if (codeAux == 0)
+                        next = 0;
+                }
+
+                feb = codeAux >> 4;
+                fec = codeAux & 15;
+
+                // The next vertex is incremented for all three vertices, before free vertices are decoded
+                a = fea == 0 ? next++ : 0;
+                b = feb == 0 ? next++ : fifos.GetVertex(feb - 1);
+                c = fec == 0 ? next++ : fifos.GetVertex(fec - 1);
+
+                if (fea == 15)
+                    last = a = DecodeIndex(cursor, last);
+                if (feb == 15)
+                    last = b = DecodeIndex(cursor, last);
+                if (fec == 15)
+                    last = c = DecodeIndex(cursor, last);
+
+                fifos.PushVertex(a);
+                fifos.PushVertex(b, feb == 0 || feb == 15);
+                fifos.PushVertex(c, fec == 0 || fec == 15);
+
+                fifos.PushEdge(b, a);
+                fifos.PushEdge(c, b);
+                fifos.PushEdge(a, c);
+            }
+
+            WriteIndex(out.data(), i + 0, indexSize, a);
+            WriteIndex(out.data(), i + 1, indexSize, b);
+            WriteIndex(out.data(), i + 2, indexSize, c);
+        }
+
+        // All triangle data has to be read, so the data ends right before the code table
+        if (cursor != dataSafeEnd)
+            ThrowMalformedData("triangle");
+    }
+
+    void DecodeMeshoptIndexSequence(std::span<uint8_t> out, size_t indexCount, size_t indexSize, std::span<const uint8_t> data)
+    {
+        CheckIndexSize(indexSize);
+        if (out.size() != indexCount * indexSize)
+            throw FailedImportError("The output buffer does not match the size of the EXT_meshopt_compression indices.");
+        // Every index takes at least one byte and the data ends with a tail, so indices can be read without bounds checks
+        if (data.size() < 1 + indexCount + SEQUENCE_TAIL_SIZE)
+            ThrowMalformedData("index sequence");
+
+        uint8_t header = data[0];
+        if ((header & 0xf0) != SEQUENCE_HEADER)
+            ThrowMalformedData("index sequence");
+        if ((header & 0x0f) > 1)
+            throw FailedImportError(FORMAT("Unsupported EXT_meshopt_compression index sequence codec version {}.", header & 0x0f));
+
+        const uint8_t* cursor = data.data() + 1;
+        const uint8_t* dataSafeEnd = data.data() + data.size() - SEQUENCE_TAIL_SIZE;
+
+        // Each index is a delta to one of the two last indices, which is selected by the lowest bit
+        uint32_t last[2] = {};
+        for (size_t i = 0; i < indexCount; i++)
+        {
+            if (cursor >= dataSafeEnd)
+                ThrowMalformedData("index sequence");
+
+            uint32_t value = DecodeVByte(cursor);
+            uint32_t baseline = value & 1;
+            value >>= 1;
+
+            uint32_t index = last[baseline] + ((value >> 1) ^ -(int32_t) (value & 1));
+            last[baseline] = index;
+            WriteIndex(out.data(), i, indexSize, index);
+        }
+
+        if (cursor != dataSafeEnd)
+            ThrowMalformedData("index sequence");
+    }
+
+    void ApplyMeshoptFilter(MeshoptFilter filter, std::span<uint8_t> data, size_t count, size_t stride)
+    {
+        if (data.size() != count * stride)
+            throw FailedImportError("The data does not match the size of the filtered EXT_meshopt_compression attributes.");
+
+        switch (filter)
+        {
+            case MeshoptFilter::None:
+                break;
+            case MeshoptFilter::Octahedral:
+                if (stride == 4)
+                    DecodeOctahedral8(data.data(), count);
+                else if (stride == 8)
+                    DecodeOctahedral16(data.data(), count);
+                else
+                    throw FailedImportError(FORMAT("The OCTAHEDRAL filter needs a byte stride of 4 or 8, but the stride is {}.", stride));
+                break;
+            case MeshoptFilter::Quaternion:
+                if (stride != 8)
+                    throw FailedImportError(FORMAT("The QUATERNION filter needs a byte stride of 8, but the stride is {}.", stride));
+                DecodeQuaternion(data.data(), count);
+                break;
+            case MeshoptFilter::Exponential:
+                if (stride % 4 != 0)
+                    throw FailedImportError(FORMAT("The EXPONENTIAL filter needs a byte stride, that is a multiple of 4, but the stride is {}.", stride));
+                DecodeExponential(data.data(), count * stride / 4);
+                break;
+        }
+    }
+
+    void DecodeMeshoptBufferView(const MeshoptCompression& compression, std::span<const uint8_t> data, std::span<uint8_t> out)
+    {
+        if (compression.Filter != MeshoptFilter::None && compression.Mode != MeshoptMode::Attributes)
+            throw FailedImportError("EXT_meshopt_compression filters can only be used with the ATTRIBUTES mode.");
+
+        switch (compression.Mode)
+        {
+            case MeshoptMode::Attributes:
+                DecodeMeshoptVertexBuffer(out, compression.Count, compression.ByteStride, data);
+                break;
+            case MeshoptMode::Triangles:
+                DecodeMeshoptIndexBuffer(out, compression.Count, compression.ByteStride, data);
+                break;
+            case MeshoptMode::Indices:
+                DecodeMeshoptIndexSequence(out, compression.Count, compression.ByteStride, data);
+                break;
+        }
+
+        ApplyMeshoptFilter(compression.Filter, out, compression.Count, compression.ByteStride);
+    }
+
+}
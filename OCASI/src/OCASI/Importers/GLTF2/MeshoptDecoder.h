@@ -0,0 +1,36 @@
+#pragma once
+
+#include "OCASI/Importers/GLTF2/Asset.h"
+
+#include <span>
+
+namespace OCASI::GLTF {
+
+    //! @brief Returns the name of the vector instruction set, that the meshopt decoders were compiled for.
+    const char* GetMeshoptInstructionSet();
+
+    /*! @brief Decodes a bufferView, that was compressed with EXT_meshopt_compression, and applies its filter.
+     *
+     *  @param data The compressed range of the buffer (compression.ByteOffset, compression.ByteLength).
+     *  @param out Receives the decoded data. It has to hold exactly compression.Count * compression.ByteStride bytes.
+     *  @throws FailedImportError If the compressed data is malformed, or the stride is not valid for the mode and filter.
+     */
+    void DecodeMeshoptBufferView(const MeshoptCompression& compression, std::span<const uint8_t> data, std::span<uint8_t> out);
+
+    /*! @brief Decodes vertexCount vertices of vertexSize bytes, that were encoded with the attribute codec.
+     *
+     *  The byte groups are unpacked, delta decoded and transposed 16 vertices at a time.
+     *  @param out Has to hold vertexCount * vertexSize bytes. vertexSize has to be a multiple of 4 and at most 256.
+     */
+    void DecodeMeshoptVertexBuffer(std::span<uint8_t> out, size_t vertexCount, size_t vertexSize, std::span<const uint8_t> data);
+
+    //! @brief Decodes a triangle list of 16 or 32 bit indices, that was encoded with the triangle codec.
+    void DecodeMeshoptIndexBuffer(std::span<uint8_t> out, size_t indexCount, size_t indexSize, std::span<const uint8_t> data);
+
+    //! @brief Decodes a sequence of 16 or 32 bit indices, that was encoded with the index sequence codec.
+    void DecodeMeshoptIndexSequence(std::span<uint8_t> out, size_t indexCount, size_t indexSize, std::span<const uint8_t> data);
+
+    //! @brief Reverts a meshopt filter in place on count elements of stride bytes.
+    void ApplyMeshoptFilter(MeshoptFilter filter, std::span<uint8_t> data, size_t count, size_t stride);
+
+}
@@ -1,55 +1,97 @@
 #include "FileParser.h"
 
 #include "OCASI/Core/StringUtil.h"
+#include "OCASI/Core/TextScanner.h"
+#include "OCASI/Core/ThreadPool.h"
+
+#include <charconv>
+#include <algorithm>
 
 namespace OCASI::OBJ {
 
+    // Files below this size are parsed on the calling thread, as splitting them up does not pay off
+    constexpr size_t PARALLEL_PARSE_MIN_FILE_SIZE = 8 * 1024 * 1024;
+    constexpr size_t PARALLEL_PARSE_MIN_CHUNK_SIZE = 1024 * 1024;
+    constexpr size_t PARALLEL_PARSE_CHUNKS_PER_THREAD = 4;
+
     FileParser::FileParser(FileReader &reader)
         : m_FileReader(reader), m_OBJModel(MakeShared<Model>())
     {}
 
+    FileParser::FileParser(FileReader& reader, const std::shared_ptr<Model>& model, Chunk& chunk)
+        : m_FileReader(reader), m_OBJModel(model), m_Chunk(&chunk),
+          m_VertexCount(chunk.VertexOffset), m_TexCoordCount(chunk.TexCoordOffset), m_NormalCount(chunk.NormalOffset)
+    {}
+
     std::shared_ptr<Model> FileParser::ParseOBJFile()
     {
-        std::vector<char> line;
-        size_t vertexCount = 0;
-        while (m_FileReader.NextLineC(line))
+        m_FileReader.Advise(MemoryAccessHint::Sequential);
+        m_FileReader.Advise(MemoryAccessHint::WillNeed);
+
+        std::string_view fileData = m_FileReader.GetFileView();
+        uint32_t threadCount = ThreadPool::GetGlobal().GetThreadCount();
+
+        if (threadCount > 1 && fileData.size() >= PARALLEL_PARSE_MIN_FILE_SIZE)
         {
-            m_Begin = line.begin();
-            m_End = line.end();
+            size_t chunkCount = std::min<size_t>(threadCount * PARALLEL_PARSE_CHUNKS_PER_THREAD, fileData.size() / PARALLEL_PARSE_MIN_CHUNK_SIZE);
+            ParseChunks(fileData, chunkCount);
+        }
+        else
+        {
+            ParseLines(fileData);
+        }
 
-            if (m_Begin == m_End)
+        return m_OBJModel;
+    }
+
+    void FileParser::ParseLines(std::string_view data)
+    {
+        // The lines are views into the mapped file data, nothing gets copied
+        Util::LineScanner scanner(data);
+        std::string_view line;
+
+        while (scanner.NextLine(line))
+        {
+            if (line.empty())
                 continue;
 
+            m_Begin = line.data();
+            m_End = line.data() + line.size();
+
             switch (*m_Begin)
             {
                 // Vertices
                 case 'v':
                 {
                     m_Begin++;
-                    switch (*m_Begin)
+                    switch (m_Begin != m_End ? *m_Begin : '\0')
                     {
                         case ' ':
                         {
                             m_Begin++;
-                            size_t spaces = Util::GetAmountOfTokens(m_Begin, m_End, ' ');
+                            uint32_t components = Util::CountTokens(m_Begin, m_End);
 
                             // vertex colours (xyz rgb)
-                            if (spaces == 5)
+                            if (components == 6)
                             {
                                 ParseVertex3D();
                                 ParseVertexColour();
                             }
-                            // Vertex with 3 components (xyz)
-                            else if (spaces == 2)
+                            // Vertex with 3 components (xyz) and an optional weight, which only applies to
+                            // rational curves and surfaces
+                            else if (components == 3 || components == 4)
                             {
                                 ParseVertex3D();
                             }
                             // Vertex with 2 components (xy)
-                            else if (spaces == 1)
+                            else if (components == 2)
                             {
                                 ParseVertex2D();
                             }
-                            vertexCount++;
+                            else
+                            {
+                                throw FailedImportError(FORMAT("Unsupported vertex with {} components: {}", components, line));
+                            }
                             break;
                         }
 
@@ -72,14 +114,16 @@ namespace OCASI::OBJ {
                 }
 
                 case 'g':
-                {
-                    ProcessGroup();
-                    break;
-                }
-
                 case 'o':
+                case 'm':
+                case 'u':
                 {
-                    ProcessObject();
+                    // The object and mesh state of a chunk depends on all previous chunks, so these statements are
+                    // processed when the chunks are merged
+                    if (m_Chunk)
+                        m_Chunk->Statements.push_back({ line, {} });
+                    else
+                        ProcessStatement(line);
                     break;
                 }
 
@@ -87,33 +131,19 @@ namespace OCASI::OBJ {
                 case 'l':
                 case 'f':
                 {
-                    // If at face assembly stage, there is no object present, create a group and an
-                    // associated mesh.
-                    if (!m_CurrentObject)
+                    if (m_Chunk)
                     {
-                        CreateObject("Object");
-                        m_CurrentObject->Meshes.push_back(CreateMesh("Mesh"));
+                        if (m_Chunk->Statements.empty() || !m_Chunk->Statements.back().Line.empty())
+                            m_Chunk->Statements.emplace_back();
+
+                        ParseFace(m_Chunk->Statements.back().Faces);
                     }
-                    else if (m_CurrentObject->Meshes.empty() && !m_GroupActive)
+                    else
                     {
-                        m_CurrentObject->Meshes.push_back(CreateMesh("Mesh"));
+                        PrepareFaceMesh();
+                        ParseFace(m_CurrentMesh->Faces);
+                        m_CurrentMesh->FaceType = m_CurrentMesh->Faces.GetFaceType(m_CurrentMesh->Faces.GetFaceCount() - 1);
                     }
-
-                    ParseFace();
-                    break;
-                }
-
-                case 'm':
-                {
-                    Util::GetToNextSpaceOrEndOfLine(m_Begin, m_End);
-                    m_Begin++;
-                    m_OBJModel->MTLFilePath = std::string(m_Begin, m_End);
-                    break;
-                }
-
-                case 'u':
-                {
-                    ProcessMaterialAssignment();
                     break;
                 }
 
@@ -127,115 +157,238 @@ namespace OCASI::OBJ {
                     break;
             }
         }
+    }
 
-        return m_OBJModel;
+    void FileParser::ParseChunks(std::string_view data, size_t chunkCount)
+    {
+        ThreadPool& pool = ThreadPool::GetGlobal();
+
+        // Splitting the file at the first line feed after every chunk's target size
+        std::vector<Chunk> chunks;
+        chunks.reserve(chunkCount);
+
+        const char* fileEnd = data.data() + data.size();
+        const char* chunkBegin = data.data();
+        for (size_t i = 1; i <= chunkCount && chunkBegin != fileEnd; i++)
+        {
+            const char* chunkEnd = fileEnd;
+            if (i < chunkCount)
+            {
+                const char* target = std::max(data.data() + data.size() / chunkCount * i, chunkBegin);
+                chunkEnd = Util::FindChar(target, fileEnd, '\n');
+                if (chunkEnd != fileEnd)
+                    chunkEnd++;
+            }
+
+            chunks.emplace_back().Data = { chunkBegin, (size_t) (chunkEnd - chunkBegin) };
+            chunkBegin = chunkEnd;
+        }
+
+        // Counting the elements of every chunk, so that each chunk knows the global index of its first element
+        pool.ParallelFor(chunks.size(), [&chunks](size_t i)
+        {
+            Chunk& chunk = chunks[i];
+            Util::LineScanner scanner(chunk.Data);
+            std::string_view line;
+
+            while (scanner.NextLine(line))
+            {
+                if (line.size() < 2 || line[0] != 'v')
+                    continue;
+
+                chunk.VertexCount += line[1] == ' ';
+                chunk.TexCoordCount += line[1] == 't';
+                chunk.NormalCount += line[1] == 'n';
+            }
+        });
+
+        for (size_t i = 1; i < chunks.size(); i++)
+        {
+            chunks[i].VertexOffset = chunks[i - 1].VertexOffset + chunks[i - 1].VertexCount;
+            chunks[i].TexCoordOffset = chunks[i - 1].TexCoordOffset + chunks[i - 1].TexCoordCount;
+            chunks[i].NormalOffset = chunks[i - 1].NormalOffset + chunks[i - 1].NormalCount;
+        }
+
+        m_OBJModel->Vertices.resize(chunks.back().VertexOffset + chunks.back().VertexCount);
+        m_OBJModel->TexCoords.resize(chunks.back().TexCoordOffset + chunks.back().TexCoordCount);
+        m_OBJModel->Normals.resize(chunks.back().NormalOffset + chunks.back().NormalCount);
+
+        // Every chunk writes its elements into its own range of the model's arrays
+        pool.ParallelFor(chunks.size(), [this, &chunks](size_t i)
+        {
+            FileParser chunkParser(m_FileReader, m_OBJModel, chunks[i]);
+            chunkParser.ParseLines(chunks[i].Data);
+        });
+
+        for (Chunk& chunk : chunks)
+            MergeChunk(chunk);
+    }
+
+    void FileParser::MergeChunk(Chunk& chunk)
+    {
+        m_OBJModel->VertexColours.insert(m_OBJModel->VertexColours.end(), chunk.VertexColours.begin(), chunk.VertexColours.end());
+
+        // Replaying the statements in file order results in the same objects and meshes as parsing on a single thread
+        for (Statement& statement : chunk.Statements)
+        {
+            if (!statement.Line.empty())
+            {
+                ProcessStatement(statement.Line);
+                continue;
+            }
+
+            PrepareFaceMesh();
+            FaceList& faces = m_CurrentMesh->Faces;
+            faces.Append(std::move(statement.Faces));
+            m_CurrentMesh->FaceType = faces.GetFaceType(faces.GetFaceCount() - 1);
+        }
+
+        m_VertexCount = chunk.VertexOffset + chunk.VertexCount;
+        m_TexCoordCount = chunk.TexCoordOffset + chunk.TexCoordCount;
+        m_NormalCount = chunk.NormalOffset + chunk.NormalCount;
+        chunk = {};
     }
 
     void FileParser::ParseVertex2D()
     {
-        m_OBJModel->Vertices.emplace_back(ParseVec2(), 0);
+        glm::vec3 vertex(ParseVec2(), 0);
+        if (m_Chunk)
+            m_OBJModel->Vertices[m_VertexCount] = vertex;
+        else
+            m_OBJModel->Vertices.push_back(vertex);
+        m_VertexCount++;
     }
 
     void FileParser::ParseVertex3D()
     {
-        m_OBJModel->Vertices.push_back(ParseVec3());
+        glm::vec3 vertex = ParseVec3();
+        if (m_Chunk)
+            m_OBJModel->Vertices[m_VertexCount] = vertex;
+        else
+            m_OBJModel->Vertices.push_back(vertex);
+        m_VertexCount++;
     }
 
     void FileParser::ParseVertexColour()
     {
-        m_OBJModel->VertexColours.push_back(ParseVec3());
+        if (m_Chunk)
+            m_Chunk->VertexColours.push_back(ParseVec3());
+        else
+            m_OBJModel->VertexColours.push_back(ParseVec3());
     }
 
     void FileParser::ParseTextureCoordinate()
     {
         m_Begin += 2;
-        m_OBJModel->TexCoords.push_back(ParseVec2());
+        glm::vec2 texCoord = ParseVec2();
+        if (m_Chunk)
+            m_OBJModel->TexCoords[m_TexCoordCount] = texCoord;
+        else
+            m_OBJModel->TexCoords.push_back(texCoord);
+        m_TexCoordCount++;
     }
 
     void FileParser::ParseNormal()
     {
         m_Begin += 2;
-        m_OBJModel->Normals.push_back(ParseVec3());
+        glm::vec3 normal = ParseVec3();
+        if (m_Chunk)
+            m_OBJModel->Normals[m_NormalCount] = normal;
+        else
+            m_OBJModel->Normals.push_back(normal);
+        m_NormalCount++;
     }
 
-    void FileParser::ParseFace()
+    void FileParser::ParseFace(FaceList& faces)
     {
-        bool hasNormals = !m_OBJModel->Normals.empty();
-        bool hasTexCoords = !m_OBJModel->TexCoords.empty();
+        bool hasNormals = m_NormalCount != 0;
+        bool hasTexCoords = m_TexCoordCount != 0;
 
-        enum Stage : uint8_t
-        {
-            Vertex = 1,
-            TexCoord = 2,
-            NormalVec = 3
-        };
-        uint8_t stage = Stage::Vertex;
-        uint8_t vertexCountPerFace = 0;
+        // Skipping the statement character
         m_Begin++;
-        Face& face = m_CurrentMesh->Faces.emplace_back();
         while (true)
         {
-            size_t iteratorStep = 1;
+            m_Begin = Util::SkipSeparators(m_Begin, m_End);
+            if (m_Begin == m_End)
+                break;
 
-            if (m_Begin == m_End || Util::IsSpace(*m_Begin))
-            {
-                if (m_Begin >= m_End)
-                    break;
+            // Every vertex is one of v, v/vt, v//vn or v/vt/vn
+            uint32_t vertexIndex = ParseFaceIndex(m_VertexCount);
+            uint32_t texCoordIndex = INVALID_INDEX;
+            uint32_t normalIndex = INVALID_INDEX;
 
-                stage = Stage::Vertex;
-                vertexCountPerFace++;
-            }
-            else if(*m_Begin == '/')
+            if (m_Begin != m_End && *m_Begin == '/')
             {
-                stage++;
-                if(stage == Stage::TexCoord && !hasTexCoords)
+                m_Begin++;
+                if (m_Begin != m_End && *m_Begin != '/')
                 {
-                    throw FailedImportError("Cannot request face indices for texture coordinates, when there are no texture coordinates defined.");
+                    if (!hasTexCoords)
+                        throw FailedImportError("Cannot request face indices for texture coordinates, when there are no texture coordinates defined.");
+
+                    texCoordIndex = ParseFaceIndex(m_TexCoordCount);
                 }
-                else if(stage == Stage::NormalVec && !hasNormals)
+
+                if (m_Begin != m_End && *m_Begin == '/')
                 {
-                    throw FailedImportError("Cannot request face indices for normals, when there are no normals defined.");
+                    m_Begin++;
+                    if (!hasNormals)
+                        throw FailedImportError("Cannot request face indices for normals, when there are no normals defined.");
+
+                    normalIndex = ParseFaceIndex(m_NormalCount);
                 }
             }
-            else
-            {
-                std::string toBeParsedString(m_Begin, m_End);
-                size_t parsedIndex = std::atof(toBeParsedString.c_str());
 
-                OCASI_ASSERT(parsedIndex != 0 || parsedIndex <= m_OBJModel->Vertices.size());
-                // Increase the iterator step by the count of digits
-                size_t temp = parsedIndex;
-                while ((temp /= 10) != 0)
-                    iteratorStep++;
+            if (m_Begin != m_End && !Util::IsSpace(*m_Begin))
+                throw FailedImportError(FORMAT("Unexpected character '{}' in face statement", *m_Begin));
 
-                parsedIndex--;
+            faces.AddVertex(vertexIndex, texCoordIndex, normalIndex);
+        }
+        faces.EndFace();
+    }
 
-                switch (stage)
-                {
-                    case Stage::Vertex:
-                    {
-                        face.VertexIndices.push_back(parsedIndex);
-                        break;
-                    }
-                    case Stage::TexCoord:
-                    {
-                        face.TextureCoordinateIndices.push_back(parsedIndex);
-                        break;
-                    }
-                    case Stage::NormalVec:
-                    {
-                        face.NormalIndices.push_back(parsedIndex);
-                        break;
-                    }
-                    default:
-                        throw FailedImportError(FORMAT("Unsupported face assembly stage {}", stage));
-                }
-            }
+    uint32_t FileParser::ParseFaceIndex(size_t elementCount)
+    {
+        // Leading zeros and signs are handled by from_chars, which stops at the first character, that is not a digit
+        int64_t index = 0;
+        auto [ptr, error] = std::from_chars(m_Begin, m_End, index);
+        if (error != std::errc() || index == 0)
+            throw FailedImportError(FORMAT("Invalid face index '{}'", std::string_view(m_Begin, Util::FindSeparator(m_Begin, m_End))));
+
+        m_Begin = ptr;
+
+        // Negative indices are relative to the elements defined so far, positive indices are one based
+        int64_t resolvedIndex = index < 0 ? (int64_t) elementCount + index : index - 1;
+        if (resolvedIndex < 0 || resolvedIndex >= (int64_t) elementCount)
+            throw FailedImportError(FORMAT("Face index {} is out of range, there are only {} elements defined", index, elementCount));
+        // Face indices are stored as 32 bit integers
+        if (resolvedIndex >= (int64_t) INVALID_INDEX)
+            throw FailedImportError(FORMAT("Face index {} exceeds the maximum supported index {}", index, INVALID_INDEX - 1));
+
+        return (uint32_t) resolvedIndex;
+    }
 
-            m_Begin += iteratorStep;
+    void FileParser::ProcessStatement(std::string_view line)
+    {
+        m_Begin = line.data();
+        m_End = line.data() + line.size();
+
+        switch (*m_Begin)
+        {
+            case 'g':
+                ProcessGroup();
+                break;
+            case 'o':
+                ProcessObject();
+                break;
+            case 'm':
+                ProcessMaterialLibrary();
+                break;
+            case 'u':
+                ProcessMaterialAssignment();
+                break;
+            default:
+                break;
         }
-        face.Type = (FaceType) vertexCountPerFace;
-        m_CurrentMesh->FaceType = (FaceType) vertexCountPerFace;
     }
 
     void FileParser::ProcessObject()
@@ -269,7 +422,7 @@ namespace OCASI::OBJ {
         m_Begin++;
         std::string name = std::string(m_Begin, m_End);
 
-        if (m_GroupActive && m_CurrentMesh->Faces.empty())
+        if (m_GroupActive && m_CurrentMesh->Faces.IsEmpty())
         {
             m_CurrentMesh->MaterialName = name;
         }
@@ -283,6 +436,28 @@ namespace OCASI::OBJ {
         }
     }
 
+    void FileParser::ProcessMaterialLibrary()
+    {
+        Util::GetToNextSpaceOrEndOfLine(m_Begin, m_End);
+        m_Begin++;
+        m_OBJModel->MTLFilePath = std::string(m_Begin, m_End);
+    }
+
+    void FileParser::PrepareFaceMesh()
+    {
+        // If at face assembly stage, there is no object present, create a group and an
+        // associated mesh.
+        if (!m_CurrentObject)
+        {
+            CreateObject("Object");
+            m_CurrentObject->Meshes.push_back(CreateMesh("Mesh"));
+        }
+        else if (m_CurrentObject->Meshes.empty() && !m_GroupActive)
+        {
+            m_CurrentObject->Meshes.push_back(CreateMesh("Mesh"));
+        }
+    }
+
     size_t FileParser::CreateObject(const std::string& name)
     {
         size_t index = m_OBJModel->RootObjects.size();
@@ -303,25 +478,17 @@ namespace OCASI::OBJ {
     }
 
     glm::vec3 FileParser::ParseVec3() {
-        std::string s1 = Util::GetToNextSpaceOrEndOfLine(m_Begin, m_End);
-        float f1 = std::stof(s1);
-
-        std::string s2 = Util::GetToNextSpaceOrEndOfLine(m_Begin, m_End);
-        float f2 = std::stof(s2);
-
-        std::string s3 = Util::GetToNextSpaceOrEndOfLine(m_Begin, m_End);
-        float f3 = std::stof(s3);
+        float f1 = Util::NextFloat(m_Begin, m_End);
+        float f2 = Util::NextFloat(m_Begin, m_End);
+        float f3 = Util::NextFloat(m_Begin, m_End);
 
         return { f1, f2, f3 };
     }
 
     glm::vec2 FileParser::ParseVec2()
     {
-        std::string s1 = Util::GetToNextSpaceOrEndOfLine(m_Begin, m_End);
-        float f1 = std::stof(s1);
-
-        std::string s2 = Util::GetToNextSpaceOrEndOfLine(m_Begin, m_End);
-        float f2 = std::stof(s2);
+        float f1 = Util::NextFloat(m_Begin, m_End);
+        float f2 = Util::NextFloat(m_Begin, m_End);
 
         return { f1, f2 };
     }
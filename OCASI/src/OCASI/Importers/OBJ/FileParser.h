@@ -15,16 +15,51 @@ namespace OCASI::OBJ {
 
         std::shared_ptr<Model> ParseOBJFile();
     private:
+        //! An object, group, usemtl or mtllib statement, or the faces between two of these statements.
+        struct Statement
+        {
+            //! Empty for a run of faces.
+            std::string_view Line;
+            FaceList Faces;
+        };
+
+        //! A newline aligned part of the file, that is parsed on its own thread.
+        struct Chunk
+        {
+            std::string_view Data;
+
+            // Element counts of the chunk and their prefix sums over all previous chunks
+            size_t VertexCount = 0, TexCoordCount = 0, NormalCount = 0;
+            size_t VertexOffset = 0, TexCoordOffset = 0, NormalOffset = 0;
+
+            // Vertex colours are not known up front, as they depend on the vertex' component count
+            std::vector<glm::vec3> VertexColours;
+            std::vector<Statement> Statements;
+        };
+
+        //! Creates a parser for a single chunk. Vertices are written into the already sized arrays of the model.
+        FileParser(FileReader& reader, const std::shared_ptr<Model>& model, Chunk& chunk);
+
+        void ParseLines(std::string_view data);
+        void ParseChunks(std::string_view data, size_t chunkCount);
+        void MergeChunk(Chunk& chunk);
+
         void ParseVertex2D();
         void ParseVertex3D();
         void ParseVertexColour();
         void ParseTextureCoordinate();
         void ParseNormal();
-        void ParseFace();
+        void ParseFace(FaceList& faces);
+        //! @brief Parses a one based or negative relative index and returns it as a zero based index.
+        uint32_t ParseFaceIndex(size_t elementCount);
 
+        void ProcessStatement(std::string_view line);
         void ProcessGroup();
         void ProcessObject();
         void ProcessMaterialAssignment();
+        void ProcessMaterialLibrary();
+        //! @brief Makes sure, that there is a mesh for the following faces.
+        void PrepareFaceMesh();
 
         size_t CreateObject(const std::string& name);
         size_t CreateMesh(const std::string& name);
@@ -33,15 +68,21 @@ namespace OCASI::OBJ {
         glm::vec3 ParseVec3();
         glm::vec2 ParseVec2();
     private:
-        using FileDataIterator = std::vector<char>::iterator;
+        // Iterates directly over the mapped file data
+        using FileDataIterator = const char*;
 
         FileReader& m_FileReader;
         std::shared_ptr<Model> m_OBJModel;
 
         FileDataIterator m_Begin, m_End;
 
+        // Only set, when parsing a single chunk of the file
+        Chunk* m_Chunk = nullptr;
+        // The number of elements parsed so far over the whole file
+        size_t m_VertexCount = 0, m_TexCoordCount = 0, m_NormalCount = 0;
+
         Mesh* m_CurrentMesh = nullptr;
         Object* m_CurrentObject = nullptr;
         bool m_GroupActive = false;
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,95 @@
+#include "Model.h"
+
+namespace OCASI::OBJ {
+
+    namespace {
+
+        void AddIndex(std::vector<uint32_t>& stream, uint32_t index, size_t vertexCount)
+        {
+            if (stream.empty())
+            {
+                if (index == INVALID_INDEX)
+                    return;
+
+                // The first vertex referencing this attribute, all previous vertices do not reference one
+                stream.resize(vertexCount - 1, INVALID_INDEX);
+            }
+            stream.push_back(index);
+        }
+
+        void AppendStream(std::vector<uint32_t>& stream, size_t vertexCount, const std::vector<uint32_t>& other, size_t otherVertexCount)
+        {
+            if (stream.empty() && other.empty())
+                return;
+
+            stream.resize(vertexCount, INVALID_INDEX);
+            if (other.empty())
+                stream.resize(vertexCount + otherVertexCount, INVALID_INDEX);
+            else
+                stream.insert(stream.end(), other.begin(), other.end());
+        }
+    }
+
+    void FaceList::AddVertex(uint32_t vertexIndex, uint32_t texCoordIndex, uint32_t normalIndex)
+    {
+        VertexIndices.push_back(vertexIndex);
+        AddIndex(TextureCoordinateIndices, texCoordIndex, VertexIndices.size());
+        AddIndex(NormalIndices, normalIndex, VertexIndices.size());
+    }
+
+    void FaceList::EndFace()
+    {
+        size_t faceBegin = Offsets.empty() ? FaceCount * FixedArity : Offsets.back();
+        size_t vertexCount = VertexIndices.size() - faceBegin;
+
+        if (FaceCount == 0)
+            FixedArity = (uint32_t) vertexCount;
+        else if (Offsets.empty() && vertexCount != FixedArity)
+            CreateOffsets();
+
+        if (!Offsets.empty())
+            Offsets.push_back(VertexIndices.size());
+
+        FaceCount++;
+    }
+
+    void FaceList::Append(FaceList&& other)
+    {
+        if (other.IsEmpty())
+            return;
+
+        if (IsEmpty())
+        {
+            *this = std::move(other);
+            return;
+        }
+
+        size_t vertexCount = VertexIndices.size();
+        AppendStream(TextureCoordinateIndices, vertexCount, other.TextureCoordinateIndices, other.VertexIndices.size());
+        AppendStream(NormalIndices, vertexCount, other.NormalIndices, other.VertexIndices.size());
+        VertexIndices.insert(VertexIndices.end(), other.VertexIndices.begin(), other.VertexIndices.end());
+
+        if (Offsets.empty() && other.Offsets.empty() && FixedArity == other.FixedArity)
+        {
+            FaceCount += other.FaceCount;
+            return;
+        }
+
+        if (Offsets.empty())
+            CreateOffsets();
+
+        Offsets.reserve(Offsets.size() + other.FaceCount);
+        for (size_t face = 0; face < other.FaceCount; face++)
+            Offsets.push_back(vertexCount + other.GetFaceEnd(face));
+
+        FaceCount += other.FaceCount;
+    }
+
+    void FaceList::CreateOffsets()
+    {
+        Offsets.resize(FaceCount + 1);
+        for (size_t face = 0; face <= FaceCount; face++)
+            Offsets[face] = face * FixedArity;
+    }
+
+}
@@ -84,13 +84,43 @@ namespace OCASI::OBJ {
         std::optional<PBRMaterialExtension> PBRExtension;
     };
 
-    struct Face
+    //! Marks a face vertex without a texture coordinate or normal.
+    constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    /*! @brief The faces of a mesh, stored as flat index streams in compressed sparse row form.
+     *
+     *  The indices of all face vertices are stored back to back. The texture coordinate and normal streams are either
+     *  empty, if no face references them, or have one entry per face vertex, with INVALID_INDEX for vertices, that do
+     *  not reference one. As long as all faces have the same vertex count, the offset array is not stored.
+     */
+    struct FaceList
     {
-        std::vector<size_t> VertexIndices;
-        std::vector<size_t> TextureCoordinateIndices;
-        std::vector<size_t> NormalIndices;
-
-        FaceType Type;
+        std::vector<uint32_t> VertexIndices;
+        std::vector<uint32_t> TextureCoordinateIndices;
+        std::vector<uint32_t> NormalIndices;
+
+        //! The offset of each face's first vertex plus the total vertex count. Empty, if all faces have FixedArity vertices.
+        std::vector<size_t> Offsets;
+        uint32_t FixedArity = 0;
+        size_t FaceCount = 0;
+
+        //! @brief Adds a vertex to the face, that is currently being built.
+        void AddVertex(uint32_t vertexIndex, uint32_t texCoordIndex, uint32_t normalIndex);
+        //! @brief Finishes the current face, which consists of all vertices added since the last call.
+        void EndFace();
+        //! @brief Appends the faces of another list. If this list is empty, the other list is moved without copying.
+        void Append(FaceList&& other);
+
+        bool IsEmpty() const { return FaceCount == 0; }
+        size_t GetFaceCount() const { return FaceCount; }
+        size_t GetFaceBegin(size_t face) const { return Offsets.empty() ? face * FixedArity : Offsets[face]; }
+        size_t GetFaceEnd(size_t face) const { return Offsets.empty() ? (face + 1) * FixedArity : Offsets[face + 1]; }
+        FaceType GetFaceType(size_t face) const { return (FaceType) (GetFaceEnd(face) - GetFaceBegin(face)); }
+        bool HasTextureCoordinates() const { return !TextureCoordinateIndices.empty(); }
+        bool HasNormals() const { return !NormalIndices.empty(); }
+
+    private:
+        void CreateOffsets();
     };
 
     struct Mesh
@@ -102,7 +132,7 @@ namespace OCASI::OBJ {
         std::string Name;
         std::string MaterialName;
 
-        std::vector<Face> Faces;
+        FaceList Faces;
 
         OCASI::FaceType FaceType = FaceType::None;
         Dimension Dim = Dimension::None;
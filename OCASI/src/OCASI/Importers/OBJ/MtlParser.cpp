@@ -1,11 +1,12 @@
 #include "MtlParser.h"
 
 #include "OCASI/Core/StringUtil.h"
+#include "OCASI/Core/TextScanner.h"
 
 namespace OCASI::OBJ {
 
-    MtlParser::MtlParser(const std::shared_ptr<Model>& model, const Path& relativePath)
-        : m_Reader(relativePath), m_Model(model)
+    MtlParser::MtlParser(const std::shared_ptr<Model>& model, FileReader reader)
+        : m_Reader(std::move(reader)), m_Model(model)
     {
     }
 
@@ -14,11 +15,14 @@ namespace OCASI::OBJ {
         if (!m_Reader.IsOpen())
             throw FailedImportError(FORMAT("Cannot open MTL file {}", m_Reader.GetPath().string()));
 
-        std::vector<char> line;
-        while (m_Reader.NextLineC(line))
+        std::string_view line;
+        while (m_Reader.NextLineView(line))
         {
-            m_Begin = line.begin();
-            m_End = line.end();
+            m_Begin = line.data();
+            m_End = line.data() + line.size();
+
+            if (m_Begin != m_End && *(m_End - 1) == '\r')
+                m_End--;
 
             if (m_Begin == m_End)
                 continue;
@@ -246,37 +250,24 @@ namespace OCASI::OBJ {
 
     float MtlParser::ParseFloat()
     {
-        std::string s = std::string(m_Begin, m_End);
-        return std::stof(s);
+        return Util::NextFloat(m_Begin, m_End);
     }
 
     glm::vec3 MtlParser::ParseVec3()
     {
-        std::string s1 = Util::GetToNextSpaceOrEndOfLine(m_Begin, m_End);
-        float f1 = std::stof(s1);
-
-        std::string s2 = Util::GetToNextSpaceOrEndOfLine(m_Begin, m_End);
-        float f2 = std::stof(s2);
-
-        std::string s3 = Util::GetToNextSpaceOrEndOfLine(m_Begin, m_End);
-        float f3 = std::stof(s3);
+        float f1 = Util::NextFloat(m_Begin, m_End);
+        float f2 = Util::NextFloat(m_Begin, m_End);
+        float f3 = Util::NextFloat(m_Begin, m_End);
 
         return { f1, f2, f3 };
     }
 
     glm::vec4 MtlParser::ParseVec4()
     {
-        std::string s1 = Util::GetToNextSpaceOrEndOfLine(m_Begin, m_End);
-        float f1 = std::stof(s1);
-
-        std::string s2 = Util::GetToNextSpaceOrEndOfLine(m_Begin, m_End);
-        float f2 = std::stof(s2);
-
-        std::string s3 = Util::GetToNextSpaceOrEndOfLine(m_Begin, m_End);
-        float f3 = std::stof(s3);
-
-        std::string s4 = Util::GetToNextSpaceOrEndOfLine(m_Begin, m_End);
-        float f4 = std::stof(s4);
+        float f1 = Util::NextFloat(m_Begin, m_End);
+        float f2 = Util::NextFloat(m_Begin, m_End);
+        float f3 = Util::NextFloat(m_Begin, m_End);
+        float f4 = Util::NextFloat(m_Begin, m_End);
 
         return { f1, f2, f3, f4 };
     }
@@ -10,7 +10,7 @@ namespace OCASI::OBJ {
     class MtlParser
     {
     public:
-        MtlParser(const std::shared_ptr<Model>& model, const Path& relativePath);
+        MtlParser(const std::shared_ptr<Model>& model, FileReader reader);
         ~MtlParser() = default;
 
         void ParseMTLFile();
@@ -27,7 +27,8 @@ namespace OCASI::OBJ {
         void CheckMaterial();
         void CreatePBRMaterialExtension();
     private:
-        using FileDataIterator = std::vector<char>::iterator;
+        // Iterates directly over the file data
+        using FileDataIterator = const char*;
 
         FileReader m_Reader;
         FileDataIterator m_Begin, m_End;
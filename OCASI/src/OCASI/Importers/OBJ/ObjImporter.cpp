@@ -2,34 +2,12 @@
 
 #include "OCASI/Importers/OBJ/FileParser.h"
 #include "OCASI/Importers/OBJ/MtlParser.h"
+#include "OCASI/Importers/OBJ/VertexIndexMap.h"
 
-#include <fstream>
-
-namespace OCASI {
-    struct VertexIndices
-    {
-        size_t VertexIndex;
-        size_t TextureCoordinateIndex;
-        size_t NormalIndex;
-
-        bool operator==(const VertexIndices& other) const
-        {
-            return VertexIndex == other.VertexIndex && TextureCoordinateIndex == other.TextureCoordinateIndex && NormalIndex == other.NormalIndex;
-        }
-    };
-}
-
-namespace std {
+#include "OCASI/Core/ThreadPool.h"
 
-    template <>
-    struct hash<OCASI::VertexIndices>
-    {
-        std::size_t operator()(const OCASI::VertexIndices& v) const
-        {
-            return std::hash<size_t>()(v.VertexIndex) + std::hash<size_t>()(v.TextureCoordinateIndex) + std::hash<size_t>()(v.NormalIndex);
-        }
-    };
-}
+#include <fstream>
+#include <algorithm>
 
 namespace OCASI {
 
@@ -56,7 +34,7 @@ namespace OCASI {
 
         if(!m_OBJModel->MTLFilePath.empty())
         {
-            OBJ::MtlParser mtlParser(m_OBJModel, folder / m_OBJModel->MTLFilePath);
+            OBJ::MtlParser mtlParser(m_OBJModel, m_FileReader->OpenRelative(m_OBJModel->MTLFilePath));
             mtlParser.ParseMTLFile();
         }
 
@@ -75,6 +53,7 @@ namespace OCASI {
 
         /// Material conversion
 
+        m_Images.clear();
         for (const auto& [name, mat] : m_OBJModel->Materials)
         {
             Material& newMat = m_OutputScene->Materials.emplace_back();
@@ -106,14 +85,25 @@ namespace OCASI {
             }
         }
 
-        if (!m_OBJModel->RootObjects.empty())
+        // The materials own the images from now on
+        m_Images.clear();
+
+        /// Node and model conversion
+
+        // Every object with meshes and every group becomes its own model, so all of them fit without reallocating
+        size_t modelCount = 0;
+        for (const OBJ::Object& o : m_OBJModel->RootObjects)
+            modelCount += (o.Meshes.empty() ? 0 : 1) + o.Groups.size();
+        m_OutputScene->Models.reserve(modelCount);
+
+        m_MeshConversions.clear();
+        for (const OBJ::Object& o : m_OBJModel->RootObjects)
         {
-            for (const OBJ::Object& o : m_OBJModel->RootObjects)
-            {
-                m_OutputScene->RootNodes.push_back(CreateNodes(o));
-            }
+            m_OutputScene->RootNodes.push_back(CreateNodes(o));
         }
 
+        ConvertMeshes();
+
         return m_OutputScene;
     }
 
@@ -128,9 +118,10 @@ namespace OCASI {
             Model& model = m_OutputScene->Models.emplace_back();
             model.Name = o.Name;
 
+            model.Meshes.resize(o.Meshes.size());
             for (size_t i = 0; i < o.Meshes.size(); i++)
             {
-                model.Meshes.push_back(CreateMesh(o.Meshes.at(i)));
+                m_MeshConversions.push_back({ node->ModelIndex, i, o.Meshes.at(i) });
             }
         }
 
@@ -143,44 +134,62 @@ namespace OCASI {
 
             Model& groupModel = m_OutputScene->Models.emplace_back();
             groupModel.Name = m_OBJModel->Meshes.at(meshIndex).Name;
-            groupModel.Meshes.push_back(CreateMesh(meshIndex));
-
+            groupModel.Meshes.resize(1);
+            m_MeshConversions.push_back({ groupNode->ModelIndex, 0, meshIndex });
         }
 
         return node;
     }
 
+    void ObjImporter::ConvertMeshes()
+    {
+        // The meshes only read from the parsed model and each one is written into its own slot, so they are converted
+        // independently. Starting with the largest meshes keeps a single big mesh from finishing last on its own.
+        std::stable_sort(m_MeshConversions.begin(), m_MeshConversions.end(), [this](const MeshConversion& a, const MeshConversion& b)
+        {
+            return m_OBJModel->Meshes.at(a.MeshIndex).Faces.VertexIndices.size() > m_OBJModel->Meshes.at(b.MeshIndex).Faces.VertexIndices.size();
+        });
+
+        ThreadPool::GetGlobal().ParallelFor(m_MeshConversions.size(), [this](size_t i)
+        {
+            const MeshConversion& conversion = m_MeshConversions.at(i);
+            m_OutputScene->Models.at(conversion.ModelIndex).Meshes.at(conversion.MeshSlot) = CreateMesh(conversion.MeshIndex);
+        });
+
+        m_MeshConversions.clear();
+    }
+
     Mesh ObjImporter::CreateMesh(size_t mesh) const
     {
         const OBJ::Mesh& m = m_OBJModel->Meshes.at(mesh);
 
         Mesh outMesh = {};
         outMesh.Name = m.Name;
-        // To generate indices and remove duplicate vertices, we have to keep track of all unique VertexIndices.
-        // This means that for every face, the indices into the global vertex arrays (vertex array, normal array, texture
-        // coordinate array) have to be checked against all already loaded indices. If there is a match, we just use the
-        // index of that matching vertex in the indices array.
-        std::unordered_map<VertexIndices, size_t> lookUpTable;
-        size_t newIndex = 0;
-        
-        for (OBJ::Face f : m.Faces)
+        // To generate indices and remove duplicate vertices, we have to keep track of all unique face vertices.
+        // This means that for every face vertex, the indices into the global vertex arrays (vertex array, normal array,
+        // texture coordinate array) have to be checked against all already loaded indices. If there is a match, we just
+        // use the index of that matching vertex in the indices array.
+        const OBJ::FaceList& faces = m.Faces;
+        size_t faceVertexCount = faces.VertexIndices.size();
+
+        // Most vertices are shared by multiple faces, so there are rarely more unique vertices than positions
+        OBJ::VertexIndexMap lookUpTable(std::min(faceVertexCount, m_OBJModel->Vertices.size()));
+        outMesh.Indices.reserve(faceVertexCount);
+        uint32_t newIndex = 0;
+
+        // The face vertices are stored back to back, so the faces do not have to be visited one by one
+        for (size_t i = 0; i < faceVertexCount; i++)
         {
-            for (size_t i = 0; i < (size_t) f.Type; i++)
-            {
-                VertexIndices indices = { f.VertexIndices.at(i),
-                                          !f.TextureCoordinateIndices.empty() ? f.TextureCoordinateIndices.at(i) : INVALID_ID,
-                                          !f.NormalIndices.empty() ? f.NormalIndices.at(i) : INVALID_ID };
-
-                auto result = lookUpTable.try_emplace(indices, newIndex);
-                if (result.second)
-                {
-                    CreateNewVertex(outMesh, indices, newIndex++);
-                }
-                else
-                {
-                    outMesh.Indices.push_back(lookUpTable.at(indices));
-                }
-            }
+            OBJ::VertexIndices indices = { faces.VertexIndices[i],
+                                           faces.HasTextureCoordinates() ? faces.TextureCoordinateIndices[i] : OBJ::INVALID_INDEX,
+                                           faces.HasNormals() ? faces.NormalIndices[i] : OBJ::INVALID_INDEX };
+
+            bool inserted = false;
+            uint32_t index = lookUpTable.TryEmplace(indices, newIndex, inserted);
+            if (inserted)
+                CreateNewVertex(outMesh, indices, newIndex++);
+            else
+                outMesh.Indices.push_back(index);
         }
 
         if (!m.MaterialName.empty())
@@ -198,15 +207,15 @@ namespace OCASI {
         return outMesh;
     }
 
-    void ObjImporter::CreateNewVertex(Mesh& mesh, const VertexIndices& indices, size_t newIndex) const
+    void ObjImporter::CreateNewVertex(Mesh& mesh, const OBJ::VertexIndices& indices, uint32_t newIndex) const
     {
         mesh.Vertices.push_back(m_OBJModel->Vertices.at(indices.VertexIndex));
         if (!m_OBJModel->VertexColours.empty())
             mesh.VertexColours.push_back(m_OBJModel->VertexColours.at(indices.VertexIndex));
 
-        if (indices.TextureCoordinateIndex != INVALID_ID)
+        if (indices.TextureCoordinateIndex != OBJ::INVALID_INDEX)
             mesh.TexCoords[OBJ_TEXTURE_COORDINATE_ARRAY].push_back(m_OBJModel->TexCoords.at(indices.TextureCoordinateIndex));
-        if (indices.NormalIndex != INVALID_ID)
+        if (indices.NormalIndex != OBJ::INVALID_INDEX)
             mesh.Normals.push_back(m_OBJModel->Normals.at(indices.NormalIndex));
 
         mesh.Indices.push_back(newIndex);
@@ -233,13 +242,13 @@ namespace OCASI {
         {
             case OBJ::TextureType::Roughness:
             {
-                auto image = MakeShared<Image>(folder / texturePath, settings);
+                auto image = CreateImage(texturePath, folder, settings);
                 newMat.SetTexture(MATERIAL_TEXTURE_ROUGHNESS, image);
                 break;
             }
             case OBJ::TextureType::Metallic:
             {
-                auto image = MakeShared<Image>(folder / texturePath, settings);
+                auto image = CreateImage(texturePath, folder, settings);
                 newMat.SetTexture(MATERIAL_TEXTURE_METALLIC, image);
                 break;
             }
@@ -248,62 +257,62 @@ namespace OCASI {
                 break;
             case OBJ::TextureType::Clearcoat:
             {
-                auto image = MakeShared<Image>(folder / texturePath, settings);
+                auto image = CreateImage(texturePath, folder, settings);
                 newMat.SetTexture(MATERIAL_TEXTURE_CLEARCOAT, image);
                 break;
             }
             case OBJ::TextureType::ClearcoatRoughness:
             {
-                auto image = MakeShared<Image>(folder / texturePath, settings);
+                auto image = CreateImage(texturePath, folder, settings);
                 newMat.SetTexture(MATERIAL_TEXTURE_CLEARCOAT_ROUGHNESS, image);
                 break;
             }
             case OBJ::TextureType::Occlusion:
             {
-                auto image = MakeShared<Image>(folder / texturePath, settings);
+                auto image = CreateImage(texturePath, folder, settings);
                 newMat.SetTexture(MATERIAL_TEXTURE_OCCLUSION, image);
                 break;
             }
             case OBJ::TextureType::Diffuse:
             {
                 // Diffuse textures are classified as the object base color
-                auto image = MakeShared<Image>(folder / texturePath, settings);
+                auto image = CreateImage(texturePath, folder, settings);
                 newMat.SetTexture(MATERIAL_TEXTURE_ALBEDO, image);
                 break;
             }
             case OBJ::TextureType::Ambient:
             {
-                auto image = MakeShared<Image>(folder / texturePath, settings);
+                auto image = CreateImage(texturePath, folder, settings);
                 newMat.SetTexture(MATERIAL_TEXTURE_AMBIENT, image);
                 break;
             }
             case OBJ::TextureType::Specular:
             {
-                auto image = MakeShared<Image>(folder / texturePath, settings);
+                auto image = CreateImage(texturePath, folder, settings);
                 newMat.SetTexture(MATERIAL_TEXTURE_SPECULAR, image);
                 break;
             }
             case OBJ::TextureType::Emissive:
             {
-                auto image = MakeShared<Image>(folder / texturePath, settings);
+                auto image = CreateImage(texturePath, folder, settings);
                 newMat.SetTexture(MATERIAL_TEXTURE_EMISSIVE, image);
                 break;
             }
             case OBJ::TextureType::Transparency:
             {
-                auto image = MakeShared<Image>(folder / texturePath, settings);
+                auto image = CreateImage(texturePath, folder, settings);
                 newMat.SetTexture(MATERIAL_TEXTURE_TRANSPARENCY, image);
                 break;
             }
             case OBJ::TextureType::Shininess:
             {
-                auto image = MakeShared<Image>(folder / texturePath, settings);
+                auto image = CreateImage(texturePath, folder, settings);
                 newMat.SetTexture(MATERIAL_TEXTURE_SPECULAR_STRENGTH, image);
                 break;
             }
             case OBJ::TextureType::Normal:
             {
-                auto image = MakeShared<Image>(folder / texturePath, settings);
+                auto image = CreateImage(texturePath, folder, settings);
                 newMat.SetTexture(MATERIAL_TEXTURE_NORMAL, image);
                 break;
             }
@@ -315,7 +324,7 @@ namespace OCASI {
             case OBJ::TextureType::ReflectionRight:
             case OBJ::TextureType::ReflectionSphere:
             {
-                auto image = MakeShared<Image>(folder / texturePath, settings);
+                auto image = CreateImage(texturePath, folder, settings);
                 newMat.SetTexture(MATERIAL_TEXTURE_REFLECTION_MAP_TOP + type - REFLECTION_TEXTURE_NORMALIZER, image);
                 break;
             }
@@ -323,4 +332,22 @@ namespace OCASI {
                 throw FailedImportError(FORMAT("Invalid OBJ texture type {}", i));
         }
     }
+
+    SharedPtr<Image> ObjImporter::CreateImage(const std::string& texturePath, const Path& folder, const ImageSettings& settings)
+    {
+        // Materials, that reference the same file with the same settings, share the image, so it is only decoded once
+        SharedPtr<Image>& image = m_Images[{ texturePath, settings.Clamp }];
+        if (image)
+            return image;
+
+        // Textures of in-memory files are resolved by the user, their compressed data is stored inside the image
+        if (auto data = m_FileReader->ResolveRelative(texturePath))
+            image = MakeShared<Image>(std::vector<uint8_t>(data->begin(), data->end()), settings);
+        else if (!m_FileReader->IsMemoryFile())
+            image = MakeShared<Image>(folder / texturePath, settings);
+        else
+            // In-memory imports never touch the disk, an unresolved texture is left out like an unresolved mtl file
+            OCASI_LOG_WARN(FORMAT("Could not resolve texture {} of an in-memory file", texturePath));
+        return image;
+    }
 }
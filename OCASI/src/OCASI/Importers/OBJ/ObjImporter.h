@@ -3,8 +3,13 @@
 #include "OCASI/Importers/OBJ/Model.h"
 #include "OCASI/Core/FileUtil.h"
 
-namespace OCASI {
+#include <map>
+
+namespace OCASI::OBJ {
     struct VertexIndices;
+}
+
+namespace OCASI {
 
     class ObjImporter : public BaseImporter
     {
@@ -15,18 +20,33 @@ namespace OCASI {
         virtual std::string_view GetLoggerPattern() const override { return "OBJ"; }
         virtual const std::vector<std::string_view> GetSupportedFileExtensions() const override { return { ".obj" }; }
         virtual ImporterType GetImporterType() const override { return ImporterType::OBJ; }
+        virtual uint32_t GetImporterVersion() const override { return 1; }
     private:
         std::shared_ptr<Scene> ConvertToOCASIScene(const Path& folder);
         std::shared_ptr<Node> CreateNodes(const OBJ::Object& o);
+        //! @brief Converts the meshes collected by CreateNodes() on the global thread pool.
+        void ConvertMeshes();
 
         Mesh CreateMesh(size_t mesh) const;
-        void CreateNewVertex(Mesh& mesh, const VertexIndices& indices, size_t newIndex) const;
+        void CreateNewVertex(Mesh& mesh, const OBJ::VertexIndices& indices, uint32_t newIndex) const;
         void SortTextures(Material& newMat, const OBJ::Material& mat, const Path& folder, size_t i);
+        SharedPtr<Image> CreateImage(const std::string& texturePath, const Path& folder, const ImageSettings& settings);
     private:
+        //! An OBJ mesh and the slot of the scene model it is converted into.
+        struct MeshConversion
+        {
+            size_t ModelIndex;
+            size_t MeshSlot;
+            size_t MeshIndex;
+        };
+
         FileReader* m_FileReader = nullptr;
 
         std::shared_ptr<OBJ::Model> m_OBJModel = nullptr;
         std::shared_ptr<Scene> m_OutputScene = nullptr;
+        std::vector<MeshConversion> m_MeshConversions;
+        //! The images created for the materials, by their relative path and clamp option. Only filled during the material conversion.
+        std::map<std::pair<std::string, ClampOption>, SharedPtr<Image>> m_Images;
     };
 
 }
\ No newline at end of file
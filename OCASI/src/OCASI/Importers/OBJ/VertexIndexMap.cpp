@@ -0,0 +1,44 @@
+#include "VertexIndexMap.h"
+
+#include <bit>
+#include <algorithm>
+
+namespace OCASI::OBJ {
+
+    // The map is kept at most half full, which keeps the probe sequences short
+    constexpr size_t MAX_LOAD_FACTOR_DIVISOR = 2;
+    constexpr size_t MIN_SLOT_COUNT = 64;
+
+    VertexIndexMap::VertexIndexMap(size_t expectedCount)
+    {
+        Allocate(std::bit_ceil(std::max(expectedCount * MAX_LOAD_FACTOR_DIVISOR, MIN_SLOT_COUNT)));
+    }
+
+    void VertexIndexMap::Grow()
+    {
+        std::vector<Slot> oldSlots = std::move(m_Slots);
+        Allocate(oldSlots.size() * 2);
+
+        for (const Slot& slot : oldSlots)
+        {
+            if (slot.MeshIndex == EMPTY_SLOT)
+                continue;
+
+            size_t index = Hash(slot.Indices) & m_Mask;
+            while (m_Slots[index].MeshIndex != EMPTY_SLOT)
+                index = (index + 1) & m_Mask;
+
+            m_Slots[index] = slot;
+            m_Size++;
+        }
+    }
+
+    void VertexIndexMap::Allocate(size_t slotCount)
+    {
+        m_Slots.assign(slotCount, Slot());
+        m_Mask = slotCount - 1;
+        m_Size = 0;
+        m_MaxSize = slotCount / MAX_LOAD_FACTOR_DIVISOR;
+    }
+
+}
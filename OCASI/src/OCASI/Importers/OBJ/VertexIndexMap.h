@@ -0,0 +1,98 @@
+#pragma once
+
+#include "OCASI/Core/Base.h"
+
+namespace OCASI::OBJ {
+
+    //! @brief The position, texture coordinate and normal index of a face vertex.
+    struct VertexIndices
+    {
+        uint32_t VertexIndex;
+        uint32_t TextureCoordinateIndex;
+        uint32_t NormalIndex;
+
+        bool operator==(const VertexIndices& other) const = default;
+    };
+
+    /*! @brief Maps unique face vertices to the index of the mesh vertex, that was created for them.
+     *
+     *  The map uses open addressing with linear probing over a flat slot array, so lookups do not allocate and
+     *  neighbouring probes share cache lines. It only supports inserting, which is all the vertex deduplication needs.
+     */
+    class VertexIndexMap
+    {
+    public:
+        //! @param expectedCount The expected number of unique vertices. The map grows, if more vertices are inserted.
+        VertexIndexMap(size_t expectedCount);
+
+        /*! @brief Looks up the face vertex and inserts it with the given mesh vertex index, if it is not present yet.
+         *
+         *  @param outInserted Set to true, if the face vertex was not present before.
+         *  @return The mesh vertex index of the face vertex.
+         */
+        uint32_t TryEmplace(const VertexIndices& indices, uint32_t newIndex, bool& outInserted)
+        {
+            size_t slot = Hash(indices) & m_Mask;
+            while (true)
+            {
+                Slot& current = m_Slots[slot];
+                if (current.MeshIndex == EMPTY_SLOT)
+                {
+                    if (m_Size + 1 > m_MaxSize)
+                    {
+                        Grow();
+                        return TryEmplace(indices, newIndex, outInserted);
+                    }
+
+                    current = { indices, newIndex };
+                    m_Size++;
+                    outInserted = true;
+                    return newIndex;
+                }
+
+                if (current.Indices == indices)
+                {
+                    outInserted = false;
+                    return current.MeshIndex;
+                }
+
+                slot = (slot + 1) & m_Mask;
+            }
+        }
+
+        size_t GetSize() const { return m_Size; }
+
+    private:
+        static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+
+        struct Slot
+        {
+            VertexIndices Indices;
+            uint32_t MeshIndex = EMPTY_SLOT;
+        };
+
+        static size_t Hash(const VertexIndices& indices)
+        {
+            // Every index is spread over the whole word before combining them, followed by the finalizer of MurmurHash3,
+            // so that permutations of the same indices end up in different slots
+            uint64_t h = indices.VertexIndex * 0x9E3779B97F4A7C15ull;
+            h ^= indices.TextureCoordinateIndex * 0xC2B2AE3D27D4EB4Full;
+            h ^= indices.NormalIndex * 0x165667B19E3779F9ull;
+            h ^= h >> 33;
+            h *= 0xFF51AFD7ED558CCDull;
+            h ^= h >> 33;
+            h *= 0xC4CEB9FE1A85EC53ull;
+            h ^= h >> 33;
+            return (size_t) h;
+        }
+
+        void Grow();
+        void Allocate(size_t slotCount);
+    private:
+        std::vector<Slot> m_Slots;
+        size_t m_Mask = 0;
+        size_t m_Size = 0;
+        size_t m_MaxSize = 0;
+    };
+
+}
@@ -2,13 +2,13 @@
 
 #include "OCASI/Core/BaseImporter.h"
 
+#include <unordered_set>
+
 namespace OCASI {
     
-    bool ConvertToRHCProcess::NeedsProcessing(SharedPtr<Scene> scene, SharedPtr<BaseImporter> importer)
+    bool ConvertToRHCProcess::SupportsImporter(const BaseImporter& importer) const
     {
-        BasePostProcess::NeedsProcessingDefault(this, scene, importer);
-        
-        switch (importer->GetImporterType())
+        switch (importer.GetImporterType())
         {
             case ImporterType::OBJ:
                 return false;
@@ -19,30 +19,31 @@ namespace OCASI {
         }
     }
     
+    bool ConvertToRHCProcess::NeedsProcessing(SharedPtr<Scene> scene, SharedPtr<BaseImporter> importer)
+    {
+        BasePostProcess::NeedsProcessingDefault(this, scene, importer);
+        return SupportsImporter(*importer);
+    }
+    
     void ConvertToRHCProcess::ExecuteProcess()
     {
-        auto& models = m_Scene->Models;
-        
-        for (auto& model : models)
+        // Vertex data, that is shared between meshes, must only be flipped once
+        std::unordered_set<std::vector<glm::vec3>*> flippedSharedAttributes;
+        for (auto& model : m_Scene->Models)
         {
+            // Meshes, that are loaded later on, are flipped once they are loaded
             for (auto& mesh : model.Meshes)
             {
-                // Flipping the vertices and normal z component, as in an RHC, the z axis points in the opposite
-                // direction as an LHC
-                for (auto& vertex : mesh.Vertices)
-                    vertex.z *= -1;
-                
-                for (auto& normal : mesh.Normals)
-                    normal.z *= -1;
+                if (!mesh.IsGeometryLoaded())
+                    continue;
                 
-                // Flipping the winding order. A right-handed coordinate system uses a counter-clockwise
-                // processing order
-                size_t triangleCount = mesh.Indices.size() / 3;
-                for (size_t i = 0; i < triangleCount; i++)
+                ProcessMesh(mesh);
+                for (auto* attribute : { mesh.SharedVertices.get(), mesh.SharedNormals.get() })
                 {
-                    size_t index = i * 3;
-                    
-                    std::swap(mesh.Indices.at(index + 0), mesh.Indices.at(index + 2));
+                    if (!attribute || !flippedSharedAttributes.insert(attribute).second)
+                        continue;
+                    for (auto& element : *attribute)
+                        element.z *= -1;
                 }
             }
         }
@@ -52,6 +53,37 @@ namespace OCASI {
             FlipRotation(rootNodes);
     }
     
+    void ConvertToRHCProcess::ProcessMesh(Mesh& mesh)
+    {
+        // Shared vertices and normals are flipped by ExecuteProcess()
+        // Flipping the vertices and normal z component, as in an RHC, the z axis points in the opposite
+        // direction as an LHC
+        for (auto& vertex : mesh.Vertices)
+            vertex.z *= -1;
+        
+        for (auto& normal : mesh.Normals)
+            normal.z *= -1;
+        
+        // Quantized attributes are flipped by their dequantization transform, which works for unsigned types too
+        for (QuantizedAttribute* attribute : { &mesh.QuantizedVertices, &mesh.QuantizedNormals })
+        {
+            if (attribute->IsEmpty())
+                continue;
+            attribute->Scale.z *= -1;
+            attribute->Offset.z *= -1;
+        }
+        
+        // Flipping the winding order. A right-handed coordinate system uses a counter-clockwise
+        // processing order
+        size_t triangleCount = mesh.Indices.size() / 3;
+        for (size_t i = 0; i < triangleCount; i++)
+        {
+            size_t index = i * 3;
+            
+            std::swap(mesh.Indices.at(index + 0), mesh.Indices.at(index + 2));
+        }
+    }
+    
     void ConvertToRHCProcess::FlipRotation(SharedPtr<Node> node)
     {
         if (!node)
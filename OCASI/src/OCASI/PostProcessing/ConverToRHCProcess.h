@@ -11,8 +11,10 @@ namespace OCASI {
         ConvertToRHCProcess() = default;
         ~ConvertToRHCProcess() = default;
         
+        virtual bool SupportsImporter(const BaseImporter& importer) const override;
         virtual bool NeedsProcessing(SharedPtr<Scene> scene, SharedPtr<BaseImporter> importer) override;
         virtual void ExecuteProcess() override;
+        virtual void ProcessMesh(Mesh& mesh) override;
         
         PostProcessorOptions GetProcessType() const override { return PostProcessorOptions::ConvertToRHC; }
     private:
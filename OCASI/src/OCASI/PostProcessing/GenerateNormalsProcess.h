@@ -12,6 +12,7 @@ namespace OCASI {
         
         virtual bool NeedsProcessing(SharedPtr<Scene> scene, SharedPtr<BaseImporter> importer) override;
         virtual void ExecuteProcess() override;
+        virtual void ProcessMesh(Mesh& mesh) override;
         virtual PostProcessorOptions GetProcessType() const override { return PostProcessorOptions::GenerateNormals; }
     private:
         // Storing the index of the model along with its mesh index
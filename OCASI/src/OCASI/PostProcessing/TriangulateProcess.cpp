@@ -14,6 +14,8 @@ namespace OCASI {
             for (size_t j = 0; j < m_Scene->Models.at(i).Meshes.size(); j++)
             {
                 const Mesh& mesh = m_Scene->Models.at(i).Meshes.at(j);
+                if (!mesh.IsGeometryLoaded())
+                    continue;
                 
                 // Triangulation of lines and points is not supported
                 if (mesh.FaceMode == FaceType::Line || mesh.FaceMode == FaceType::Point)
@@ -36,31 +38,37 @@ namespace OCASI {
     {
         for (auto [model, meshIndex] : m_ModelsWithProcessingNeed)
         {
-            Mesh& mesh = m_Scene->Models.at(model).Meshes.at(meshIndex);
-            
-            auto oldIndices = mesh.Indices;
-            auto& newIndices = mesh.Indices;
-            // A quad has 4 vertices. To triangulate a quad, 2 triangles are needed,
-            // resulting in 6 vertices for each quad. (4 * 1.5 = 6)
-            newIndices.clear();
-            newIndices.reserve((size_t)((float)oldIndices.size() * 1.5));
-            for (size_t i = 0; i < oldIndices.size(); i += 4)
-            {
-                // The first triangle is always the combination of the first
-                // 3 indices, in order as specified in oldIndices.
-                newIndices.push_back(oldIndices.at(i + 0));
-                newIndices.push_back(oldIndices.at(i + 1));
-                newIndices.push_back(oldIndices.at(i + 2));
-                
-                // The second triangle is always the first index and the last
-                // index of the quad, combined with the remaining, until now,
-                // unused vertex.
-                newIndices.push_back(oldIndices.at(i + 0));
-                newIndices.push_back(oldIndices.at(i + 2));
-                newIndices.push_back(oldIndices.at(i + 3));
-            }
+            ProcessMesh(m_Scene->Models.at(model).Meshes.at(meshIndex));
+        }
+    }
+    
+    void TriangulateProcess::ProcessMesh(Mesh& mesh)
+    {
+        if (mesh.FaceMode != FaceType::Quad)
+            return;
+        
+        auto oldIndices = mesh.Indices;
+        auto& newIndices = mesh.Indices;
+        // A quad has 4 vertices. To triangulate a quad, 2 triangles are needed,
+        // resulting in 6 vertices for each quad. (4 * 1.5 = 6)
+        newIndices.clear();
+        newIndices.reserve((size_t)((float)oldIndices.size() * 1.5));
+        for (size_t i = 0; i < oldIndices.size(); i += 4)
+        {
+            // The first triangle is always the combination of the first
+            // 3 indices, in order as specified in oldIndices.
+            newIndices.push_back(oldIndices.at(i + 0));
+            newIndices.push_back(oldIndices.at(i + 1));
+            newIndices.push_back(oldIndices.at(i + 2));
             
-            mesh.FaceMode = FaceType::Triangle;
+            // The second triangle is always the first index and the last
+            // index of the quad, combined with the remaining, until now,
+            // unused vertex.
+            newIndices.push_back(oldIndices.at(i + 0));
+            newIndices.push_back(oldIndices.at(i + 2));
+            newIndices.push_back(oldIndices.at(i + 3));
         }
+        
+        mesh.FaceMode = FaceType::Triangle;
     }
 }
\ No newline at end of file
@@ -12,6 +12,7 @@ namespace OCASI {
         
         virtual bool NeedsProcessing(SharedPtr<Scene> scene, SharedPtr<BaseImporter> importer) override;
         virtual void ExecuteProcess() override;
+        virtual void ProcessMesh(Mesh& mesh) override;
         
         PostProcessorOptions GetProcessType() const override { return PostProcessorOptions::Triangulate; }
     private: